@@ -0,0 +1,204 @@
+// Micro-benchmark for lfonts_core: renders the engine with the default eight
+// lanes enabled, live (once per kernel ISA this CPU runs) and from the cycle
+// cache, and reports the cost per sample; then the cost at 1..maxLanes lanes
+// of mixed divisions. Also checks the other ISAs and the cached and chunked
+// (offline) paths against the baseline live one. Built as lfonts_bench (no
+// JUCE needed); CTest runs it for a second.
+//
+//   lfonts_bench [seconds] [sampleRate]
+//
+// Fails (exit code 1) if a check strays past its tolerance, or with
+// PLF_RT_CHECK if the engine allocated or locked inside the render loop.
+#include "LfoEngine.h"
+#include "RtCheck.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+int main(int argc, char **argv)
+{
+    const double seconds = argc > 1 ? std::atof(argv[1]) : 60.0;
+    const double sampleRate = argc > 2 ? std::atof(argv[2]) : 48000.0;
+    constexpr int blockSize = 512;
+
+    LfoEngine::Params params;
+    for (int i = 0; i < LfoEngine::maxLanes; ++i)
+    {
+        // default layout, then every named division in turn
+        const int division = i < LfoEngine::defaultNumLanes ? LfoEngine::getDefaultDivisionIndex(i)
+                                                            : i % LfoEngine::numNamedDivisions;
+        auto &lp = params.lanes[(size_t)i];
+        lp.division = LfoEngine::namedDivisions[division].division;
+        lp.enabled = true;
+        lp.mix = 0.12f;                  // keeps the sum below the clamp
+        lp.phaseDeg = 45.0f * (float)i;
+        lp.intensityA = 0.75f;           // pre-gain branch
+        lp.curvRiseA = 0.5f;             // convex
+        lp.curvFallB = -0.5f;            // concave
+        lp.riseB = 2.0f;
+        lp.invertB = 0.25f;
+    }
+    params.global.slope = 0.25f;
+    params.global.slopeCurve = 0.75f;
+
+    const auto makeEngine = [&](bool cached, LaneKernels::Isa isa = LaneKernels::getBest())
+    {
+        LfoEngine engine;
+        engine.forceIsa(isa);
+        engine.prepare(sampleRate);
+        engine.setCycleCacheEnabled(cached);
+        engine.setGlobals(params.global);
+        for (int i = 0; i < LfoEngine::maxLanes; ++i)
+            engine.setLane(i, params.lanes[(size_t)i]);
+        return engine;
+    };
+
+    const long long numBlocks = (long long)(seconds * sampleRate / blockSize);
+    const double samples = (double)numBlocks * blockSize;
+
+    // Time one engine over the whole run
+    const auto run = [&](const char *label, bool cached, LaneKernels::Isa isa)
+    {
+        auto engine = makeEngine(cached, isa);
+        std::vector<float> out(blockSize);
+        double checksum = 0.0;
+
+        const auto t0 = std::chrono::steady_clock::now();
+        {
+            PLF_RT_SCOPE();
+            for (long long b = 0; b < numBlocks; ++b)
+            {
+                if (!engine.beginBlock(120.0))
+                    continue;
+                for (int start = 0; start < blockSize; start += LfoEngine::maxChunk)
+                    engine.render(out.data() + start, LfoEngine::maxChunk);
+                checksum += out[blockSize - 1];
+            }
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+
+        const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        std::printf("%-12s %-7s %.0f samples (%.1f s at %.0f Hz), %.2f ns/sample, %.1fx real time (checksum %.6f)\n",
+                    label, LaneKernels::getName(isa), samples, samples / sampleRate, sampleRate, ns / samples,
+                    (samples / sampleRate) / (ns * 1.0e-9), checksum);
+    };
+
+    // A deviation past its tolerance fails the run
+    bool passed = true;
+    const auto check = [&](float maxDiff, float tolerance)
+    {
+        if (maxDiff > tolerance)
+        {
+            std::printf("  FAILED: tolerance %.3g\n", (double)tolerance);
+            passed = false;
+        }
+    };
+
+    for (int i = 0; i < LaneKernels::numIsas; ++i)
+        if (LaneKernels::isSupported((LaneKernels::Isa)i))
+            run("live:", false, (LaneKernels::Isa)i);
+    run("cycle cache:", true, LaneKernels::getBest());
+
+    // Cost against the number of lanes (live, mixes scaled to stay below the clamp)
+    for (const int numLanes : {1, 8, 16, LfoEngine::maxLanes})
+    {
+        const auto saved = params;
+        params.global.numLanes = numLanes;
+        for (auto &lp : params.lanes)
+            lp.mix = 0.96f / (float)numLanes;
+
+        char label[32];
+        std::snprintf(label, sizeof(label), "%d lanes:", numLanes);
+        run(label, false, LaneKernels::getBest());
+        params = saved;
+    }
+
+    // Wider ISAs against the baseline (FMA contraction may move the last bits:
+    // a few ULP of full scale)
+    for (int i = 1; i < LaneKernels::numIsas; ++i)
+    {
+        const auto isa = (LaneKernels::Isa)i;
+        if (!LaneKernels::isSupported(isa))
+            continue;
+
+        auto base = makeEngine(false, LaneKernels::Isa::baseline), wide = makeEngine(false, isa);
+        std::vector<float> a(LfoEngine::maxChunk), b(LfoEngine::maxChunk);
+        float maxDiff = 0.0f;
+        for (long long blk = 0; blk < numBlocks; ++blk)
+        {
+            base.beginBlock(120.0);
+            wide.beginBlock(120.0);
+            for (int start = 0; start < blockSize; start += LfoEngine::maxChunk)
+            {
+                base.render(a.data(), LfoEngine::maxChunk);
+                wide.render(b.data(), LfoEngine::maxChunk);
+                for (int k = 0; k < LfoEngine::maxChunk; ++k)
+                    maxDiff = std::max(maxDiff, std::abs(a[(size_t)k] - b[(size_t)k]));
+            }
+        }
+        std::printf("%-12s %-7s max deviation from %s %.3g\n", "kernels:", LaneKernels::getName(isa),
+                    LaneKernels::getName(LaneKernels::Isa::baseline), (double)maxDiff);
+        check(maxDiff, 4.0f * std::numeric_limits<float>::epsilon());
+    }
+
+    // Both paths in lockstep: how far the replayed output strays from the live one
+    {
+        auto live = makeEngine(false), cached = makeEngine(true);
+        std::vector<float> a(LfoEngine::maxChunk), b(LfoEngine::maxChunk);
+        float maxDiff = 0.0f;
+        long long replayed = 0;
+        for (long long blk = 0; blk < numBlocks; ++blk)
+        {
+            live.beginBlock(120.0);
+            cached.beginBlock(120.0);
+            for (int start = 0; start < blockSize; start += LfoEngine::maxChunk)
+            {
+                replayed += cached.isReplayingCycle() ? LfoEngine::maxChunk : 0;
+                live.render(a.data(), LfoEngine::maxChunk);
+                cached.render(b.data(), LfoEngine::maxChunk);
+                for (int k = 0; k < LfoEngine::maxChunk; ++k)
+                    maxDiff = std::max(maxDiff, std::abs(a[(size_t)k] - b[(size_t)k]));
+            }
+        }
+        std::printf("cycle cache: %.1f%% replayed, max deviation from live %.3g\n",
+                    100.0 * (double)replayed / samples, (double)maxDiff);
+        check(maxDiff, 0.0f);
+    }
+
+    // Offline path: blocks rendered as independent chunks, then stitched
+    {
+        auto live = makeEngine(false), chunked = makeEngine(false);
+        constexpr int numChunks = 4;
+        std::vector<float> a(blockSize), b(blockSize);
+        std::vector<LfoEngine::ChunkScratch> scratch(numChunks);
+        float maxDiff = 0.0f;
+        for (long long blk = 0; blk < numBlocks; ++blk)
+        {
+            live.beginBlock(120.0);
+            for (int start = 0; start < blockSize; start += LfoEngine::maxChunk)
+                live.render(a.data() + start, LfoEngine::maxChunk);
+
+            chunked.beginBlock(120.0);
+            for (int c = 0; c < numChunks; ++c)
+                chunked.renderMixChunk(c * blockSize / numChunks, blockSize / numChunks,
+                                       b.data() + c * blockSize / numChunks, scratch[(size_t)c]);
+            chunked.finishBlock(b.data(), b.data(), blockSize, scratch.data(), numChunks);
+
+            for (int k = 0; k < blockSize; ++k)
+                maxDiff = std::max(maxDiff, std::abs(a[(size_t)k] - b[(size_t)k]));
+        }
+        std::printf("chunked:     max deviation from live %.3g\n", (double)maxDiff);
+        check(maxDiff, 0.0f);
+    }
+
+    if (RtCheck::getNumViolations() > 0)
+    {
+        std::fputs(RtCheck::getReport().c_str(), stderr);
+        return 1;
+    }
+    return passed ? 0 : 1;
+}
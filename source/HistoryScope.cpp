@@ -0,0 +1,103 @@
+#include "HistoryScope.h"
+#include "UiProfiler.h"
+#include <vector>
+
+namespace
+{
+    constexpr float kHistorySeconds = 4.0f;
+    // Bins this close to the write position's wrap-around may be mid-overwrite
+    constexpr int kReadMargin = 1024;
+}
+
+HistoryScope::HistoryScope(const OutputHistory &source)
+    : history(source), vblank(this, [this]
+                              { onVBlank(); })
+{
+    setInterceptsMouseClicks(false, false);
+}
+
+void HistoryScope::onVBlank()
+{
+    // Hidden: nothing to do; the history keeps itself and we catch up when shown
+    if (!isShowing() || history.getNumBinsWritten() == lastPainted)
+        return;
+
+    repaint();
+}
+
+void HistoryScope::paint(juce::Graphics &g)
+{
+    PLF_PROFILE_UI("HistoryScope::paint");
+
+    auto r = plotArea();
+    if (r.isEmpty())
+        return;
+
+    const auto grid = findColour(juce::Slider::trackColourId);
+    const auto wave = findColour(juce::Slider::thumbColourId);
+    const float yBottom = r.getBottom(), amp = r.getHeight();
+
+    g.setColour(grid.withAlpha(0.45f));
+    g.drawLine({r.getX(), yBottom, r.getRight(), yBottom}, 1.0f);
+
+    // One-second ticks, counted back from "now" at the right edge
+    g.setColour(grid.withAlpha(0.25f));
+    for (int s = 1; s < (int)kHistorySeconds; ++s)
+        g.drawVerticalLine(juce::roundToInt(r.getRight() - r.getWidth() * (float)s / kHistorySeconds), r.getY(), yBottom);
+
+    g.setColour(grid.withAlpha(0.9f));
+    g.setFont(juce::Font(juce::FontOptions(12.0f)));
+    g.drawText("live output, " + juce::String((int)kHistorySeconds) + " s",
+               r.withHeight(16.0f).reduced(4.0f, 0.0f), juce::Justification::topRight, false);
+
+    const auto written = history.getNumBinsWritten();
+    lastPainted = written;
+
+    const auto shown = (juce::uint64)juce::jlimit(1, OutputHistory::capacity - kReadMargin,
+                                                  juce::roundToInt(kHistorySeconds / history.getBinSeconds()));
+    const auto available = juce::jmin(written, shown);
+    if (available < 2)
+        return;
+
+    // Columns cover a fixed time span; the part not yet recorded stays empty
+    const int cols = juce::jmax(1, (int)r.getWidth());
+    const double binsPerCol = (double)shown / (double)cols;
+    const auto first = written - shown; // may "underflow" for young histories: skipped below
+
+    std::vector<float> colMin((size_t)cols), colMax((size_t)cols);
+    int firstCol = cols;
+    for (int x = cols; --x >= 0;)
+    {
+        const auto b0 = (juce::uint64)((double)x * binsPerCol);
+        const auto b1 = juce::jmax(b0 + 1, (juce::uint64)((double)(x + 1) * binsPerCol));
+        if (shown - b0 > available)
+            break; // older than anything recorded
+
+        auto range = history.getBin(first + b0);
+        for (auto b = b0 + 1; b < b1; ++b)
+            range = range.getUnionWith(history.getBin(first + b));
+
+        colMin[(size_t)x] = juce::jlimit(0.0f, 1.0f, range.getStart());
+        colMax[(size_t)x] = juce::jlimit(0.0f, 1.0f, range.getEnd());
+        firstCol = x;
+    }
+    if (firstCol >= cols - 1)
+        return;
+
+    juce::Path band;
+    band.preallocateSpace((cols - firstCol) * 6 + 8);
+    for (int x = firstCol; x < cols; ++x)
+    {
+        const float px = r.getX() + (float)x + 0.5f;
+        const float py = yBottom - colMax[(size_t)x] * amp;
+        (x == firstCol ? band.startNewSubPath(px, py) : band.lineTo(px, py));
+    }
+    for (int x = cols; --x >= firstCol;)
+        band.lineTo(r.getX() + (float)x + 0.5f, yBottom - colMin[(size_t)x] * amp);
+    band.closeSubPath();
+
+    g.setColour(wave.withAlpha(0.55f));
+    g.fillPath(band);
+    g.setColour(wave);
+    g.strokePath(band, juce::PathStrokeType(1.25f));
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <JuceHeader.h>
+#include "OutputHistory.h"
+
+// ---------------------------------------------------------------------------
+// Rolling view of the rendered output envelope (newest on the right).
+//
+// Reads the processor's OutputHistory directly: on each vblank it only checks
+// whether new bins arrived, and paint() folds the visible bins into one
+// min/max pair per pixel column. Nothing is evaluated analytically, so mix
+// smoothing, retrig fades and the output smoother show up exactly as rendered.
+// ---------------------------------------------------------------------------
+class HistoryScope : public juce::Component
+{
+public:
+    explicit HistoryScope(const OutputHistory &source);
+
+    void paint(juce::Graphics &) override;
+
+private:
+    void onVBlank();
+
+    juce::Rectangle<float> plotArea() const { return getLocalBounds().toFloat().reduced(8.0f, 6.0f); }
+
+    const OutputHistory &history;
+    juce::uint64 lastPainted = 0;
+    juce::VBlankAttachment vblank;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HistoryScope)
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <JuceHeader.h>
+#include "UiProfiler.h"
 
 struct PinkLookAndFeel : juce::LookAndFeel_V4
 {
@@ -23,6 +24,8 @@ struct PinkLookAndFeel : juce::LookAndFeel_V4
                           float sliderPos, float /*min*/, float /*max*/,
                           const juce::Slider::SliderStyle style, juce::Slider &s) override
     {
+        PLF_PROFILE_UI("PinkLookAndFeel::drawLinearSlider");
+
         auto back = findColour(juce::Slider::backgroundColourId);
         auto track = findColour(juce::Slider::trackColourId);
         auto thumb = findColour(juce::Slider::thumbColourId);
@@ -66,17 +69,40 @@ struct PinkLookAndFeel : juce::LookAndFeel_V4
     void drawRotarySlider(juce::Graphics &g, int x, int y, int w, int h,
                           float pos, float a0, float a1, juce::Slider &) override
     {
-        auto b = juce::Rectangle<float>(float(x), float(y), float(w), float(h)).reduced(4);
-        auto r = b.getWidth() < b.getHeight() ? b.withSizeKeepingCentre(b.getWidth(), b.getWidth())
-                                              : b.withSizeKeepingCentre(b.getHeight(), b.getHeight());
+        PLF_PROFILE_UI("PinkLookAndFeel::drawRotarySlider");
 
-        auto track = findColour(juce::Slider::trackColourId);
-        auto back = findColour(juce::Slider::backgroundColourId);
-        auto thumb = findColour(juce::Slider::thumbColourId);
+        drawKnobRing(g, juce::Rectangle<float>(float(x), float(y), float(w), float(h)), pos, a0, a1,
+                     findColour(juce::Slider::backgroundColourId),
+                     findColour(juce::Slider::trackColourId),
+                     findColour(juce::Slider::thumbColourId));
+    }
+
+    // The knob itself, shared with components that paint their own rings (LanePanel).
+    // Face and value are split so callers can cache the static face.
+    static void drawKnobRing(juce::Graphics &g, juce::Rectangle<float> bounds, float pos, float a0, float a1,
+                             juce::Colour back, juce::Colour track, juce::Colour thumb)
+    {
+        drawKnobFace(g, bounds, back);
+        drawKnobValue(g, bounds, pos, a0, a1, track, thumb);
+    }
 
-        // face
+    static juce::Rectangle<float> knobArea(juce::Rectangle<float> bounds)
+    {
+        auto b = bounds.reduced(4);
+        return b.getWidth() < b.getHeight() ? b.withSizeKeepingCentre(b.getWidth(), b.getWidth())
+                                            : b.withSizeKeepingCentre(b.getHeight(), b.getHeight());
+    }
+
+    static void drawKnobFace(juce::Graphics &g, juce::Rectangle<float> bounds, juce::Colour back)
+    {
         g.setColour(back.darker(0.30f));
-        g.fillEllipse(r);
+        g.fillEllipse(knobArea(bounds));
+    }
+
+    static void drawKnobValue(juce::Graphics &g, juce::Rectangle<float> bounds, float pos, float a0, float a1,
+                              juce::Colour track, juce::Colour thumb)
+    {
+        const auto r = knobArea(bounds);
 
         // progress arc
         juce::Path p;
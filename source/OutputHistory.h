@@ -0,0 +1,103 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+// Lock-free history of what processBlock actually outputs.
+//
+// The audio thread folds its output envelope into fixed-length bins and
+// publishes one min/max pair per finished bin (a single 64-bit atomic store),
+// then bumps the write counter. Readers on any thread look at the last bins
+// behind the counter; the ring is large enough that a reader a few frames
+// behind never sees a slot being overwritten.
+// ---------------------------------------------------------------------------
+class OutputHistory
+{
+public:
+    static constexpr int capacity = 8192; // bins (power of two)
+
+    // Not while processBlock runs (prepareToPlay)
+    void prepare(double sampleRate, float binMs = 1.0f)
+    {
+        binSamples = juce::jmax(1, juce::roundToInt(sampleRate * binMs * 0.001));
+        binSeconds.store((float)binSamples / (float)sampleRate, std::memory_order_relaxed);
+        accCount = 0;
+    }
+
+    // ---- audio thread ----
+    void push(const float *x, int n)
+    {
+        while (n > 0)
+        {
+            const int take = juce::jmin(n, binSamples - accCount);
+            const auto range = juce::FloatVectorOperations::findMinAndMax(x, take);
+            accMin = accCount == 0 ? range.getStart() : juce::jmin(accMin, range.getStart());
+            accMax = accCount == 0 ? range.getEnd() : juce::jmax(accMax, range.getEnd());
+
+            accCount += take;
+            x += take;
+            n -= take;
+
+            if (accCount == binSamples)
+                publish();
+        }
+    }
+
+    // Silent blocks (nothing rendered) still move the history along
+    void pushSilence(int n)
+    {
+        while (n > 0)
+        {
+            const int take = juce::jmin(n, binSamples - accCount);
+            accMin = accCount == 0 ? 0.0f : juce::jmin(accMin, 0.0f);
+            accMax = accCount == 0 ? 0.0f : juce::jmax(accMax, 0.0f);
+
+            accCount += take;
+            n -= take;
+
+            if (accCount == binSamples)
+                publish();
+        }
+    }
+
+    // ---- readers ----
+    // Number of bins written so far; bins [count - capacity, count) are readable
+    juce::uint64 getNumBinsWritten() const { return written.load(std::memory_order_acquire); }
+    float getBinSeconds() const { return binSeconds.load(std::memory_order_relaxed); }
+
+    // Min / max of bin `index` (absolute, see getNumBinsWritten)
+    juce::Range<float> getBin(juce::uint64 index) const
+    {
+        const auto bits = bins[(size_t)(index & (capacity - 1))].load(std::memory_order_relaxed);
+        float lo, hi;
+        const auto l = (juce::uint32)bits, h = (juce::uint32)(bits >> 32);
+        std::memcpy(&lo, &l, sizeof(lo));
+        std::memcpy(&hi, &h, sizeof(hi));
+        return {lo, hi};
+    }
+
+private:
+    void publish()
+    {
+        juce::uint32 l, h;
+        std::memcpy(&l, &accMin, sizeof(l));
+        std::memcpy(&h, &accMax, sizeof(h));
+
+        const auto w = written.load(std::memory_order_relaxed);
+        bins[(size_t)(w & (capacity - 1))].store((juce::uint64)l | ((juce::uint64)h << 32), std::memory_order_relaxed);
+        written.store(w + 1, std::memory_order_release);
+        accCount = 0;
+    }
+
+    static_assert((capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+
+    std::array<std::atomic<juce::uint64>, capacity> bins{};
+    std::atomic<juce::uint64> written{0};
+    std::atomic<float> binSeconds{0.001f};
+
+    // audio thread only
+    int binSamples = 48, accCount = 0;
+    float accMin = 0.0f, accMax = 0.0f;
+};
@@ -0,0 +1,305 @@
+#include "OverviewScope.h"
+#include "UiProfiler.h"
+#include <cmath>
+
+namespace
+{
+    constexpr int kSamplesPerCycle = 1 << 15;  // level-0 resolution per lane-1 cycle
+    constexpr int kMinSamples = 1 << 10;
+    constexpr int kMaxSamples = 1 << 20;       // ~16 MB of pyramid at most (min + max, all levels)
+    constexpr int kEvalBlock = 4096;           // phases per evaluator call
+    constexpr double kWheelZoom = 1.5;         // zoom factor per wheel notch
+}
+
+OverviewScope::OverviewScope()
+{
+    builder.startThread(juce::Thread::Priority::background);
+}
+
+OverviewScope::~OverviewScope()
+{
+    requested.fetch_add(1); // abandons a build in flight
+    builder.signalThreadShouldExit();
+    builder.notify();
+    builder.stopThread(2000);
+    cancelPendingUpdate();
+}
+
+void OverviewScope::setSource(Evaluator fn, LengthFn length)
+{
+    {
+        const juce::SpinLock::ScopedLockType sl(sourceLock);
+        evaluator = std::move(fn);
+        patternLength = std::move(length);
+    }
+    invalidate();
+}
+
+void OverviewScope::invalidate()
+{
+    if (!isShowing())
+    {
+        staleWhileHidden = true;
+        return;
+    }
+    staleWhileHidden = false;
+
+    requested.fetch_add(1);
+    builder.notify();
+}
+
+void OverviewScope::visibilityChanged()
+{
+    if (staleWhileHidden && isShowing())
+        invalidate();
+}
+
+// ==================== builder thread ====================
+
+void OverviewScope::Builder::run()
+{
+    int built = 0;
+    while (!threadShouldExit())
+    {
+        const int generation = owner.requested.load();
+        if (generation == built)
+        {
+            wait(-1);
+            continue;
+        }
+
+        if (auto result = owner.build(generation))
+        {
+            built = generation;
+            {
+                const juce::SpinLock::ScopedLockType sl(owner.pendingLock);
+                owner.pending = std::move(result);
+            }
+            owner.triggerAsyncUpdate();
+        }
+    }
+}
+
+std::unique_ptr<OverviewScope::Pyramid> OverviewScope::build(int generation)
+{
+    PLF_PROFILE_UI("OverviewScope::build (builder)");
+
+    Evaluator eval;
+    LengthFn length;
+    {
+        const juce::SpinLock::ScopedLockType sl(sourceLock);
+        eval = evaluator;
+        length = patternLength;
+    }
+    if (!eval)
+        return nullptr;
+
+    auto p = std::make_unique<Pyramid>();
+    p->lengthCycles = length ? juce::jmax(1.0e-3, length()) : 1.0;
+
+    const int n = juce::jlimit(kMinSamples, kMaxSamples, (int)std::ceil(p->lengthCycles * kSamplesPerCycle));
+
+    // Level 0: the samples themselves
+    std::vector<float> samples((size_t)n);
+    float phases[kEvalBlock];
+    for (int start = 0; start < n; start += kEvalBlock)
+    {
+        if (requested.load() != generation || builder.threadShouldExit())
+            return nullptr; // superseded; start over with the new parameters
+
+        const int count = juce::jmin(kEvalBlock, n - start);
+        for (int k = 0; k < count; ++k)
+            phases[k] = (float)((double)(start + k) / (double)n * p->lengthCycles);
+
+        eval(phases, samples.data() + start, count);
+    }
+    juce::FloatVectorOperations::clip(samples.data(), samples.data(), 0.0f, 1.0f, n);
+
+    p->mins.push_back(samples);
+    p->maxs.push_back(std::move(samples));
+
+    // Every level above pairs up the bins of the one below
+    while (p->mins.back().size() > 1)
+    {
+        const auto &lo = p->mins.back();
+        const auto &hi = p->maxs.back();
+        const size_t m = (lo.size() + 1) / 2;
+
+        std::vector<float> mn(m), mx(m);
+        for (size_t i = 0; i < m; ++i)
+        {
+            const size_t a = 2 * i, b = juce::jmin(a + 1, lo.size() - 1);
+            mn[i] = juce::jmin(lo[a], lo[b]);
+            mx[i] = juce::jmax(hi[a], hi[b]);
+        }
+        p->mins.push_back(std::move(mn));
+        p->maxs.push_back(std::move(mx));
+    }
+
+    return p;
+}
+
+void OverviewScope::handleAsyncUpdate()
+{
+    // shown again via a parent (no visibilityChanged here): catch up now
+    if (staleWhileHidden && isShowing())
+        invalidate();
+
+    {
+        const juce::SpinLock::ScopedLockType sl(pendingLock);
+        if (pending == nullptr)
+            return;
+        pyramid = std::move(pending);
+    }
+    setView(viewStart, viewLength); // the pattern length may have changed the zoom limit
+    repaint();
+}
+
+// ==================== view ====================
+
+double OverviewScope::minViewLength() const
+{
+    // never zoom past one level-0 sample per pixel
+    const int n = pyramid != nullptr ? pyramid->numSamples() : 0;
+    return n > 0 ? juce::jmin(1.0, (double)juce::jmax(1, getWidth()) / (double)n) : 1.0;
+}
+
+void OverviewScope::setView(double start, double length)
+{
+    viewLength = juce::jlimit(minViewLength(), 1.0, length);
+    viewStart = juce::jlimit(0.0, 1.0 - viewLength, start);
+}
+
+void OverviewScope::mouseDown(const juce::MouseEvent &)
+{
+    dragStartView = viewStart;
+}
+
+void OverviewScope::mouseDrag(const juce::MouseEvent &e)
+{
+    const float w = juce::jmax(1.0f, plotArea().getWidth());
+    setView(dragStartView - (double)e.getDistanceFromDragStartX() / w * viewLength, viewLength);
+    repaint();
+}
+
+void OverviewScope::mouseDoubleClick(const juce::MouseEvent &)
+{
+    setView(0.0, 1.0);
+    repaint();
+}
+
+void OverviewScope::mouseWheelMove(const juce::MouseEvent &e, const juce::MouseWheelDetails &wheel)
+{
+    const auto r = plotArea();
+    const float delta = wheel.deltaY * (wheel.isReversed ? -1.0f : 1.0f);
+    if (delta == 0.0f || r.getWidth() <= 0.0f)
+    {
+        juce::Component::mouseWheelMove(e, wheel);
+        return;
+    }
+
+    // keep the pattern position under the mouse where it is
+    const double x01 = juce::jlimit(0.0, 1.0, (double)((e.position.x - r.getX()) / r.getWidth()));
+    const double anchor = viewStart + x01 * viewLength;
+    const double newLength = juce::jlimit(minViewLength(), 1.0, viewLength * std::pow(kWheelZoom, -(double)delta * 4.0));
+
+    setView(anchor - x01 * newLength, newLength);
+    repaint();
+}
+
+// ==================== paint ====================
+
+void OverviewScope::paint(juce::Graphics &g)
+{
+    PLF_PROFILE_UI("OverviewScope::paint");
+
+    if (staleWhileHidden)
+        triggerAsyncUpdate(); // painting means we're visible again
+
+    auto r = plotArea();
+    if (r.isEmpty())
+        return;
+
+    const auto grid = findColour(juce::Slider::trackColourId);
+    const auto wave = findColour(juce::Slider::thumbColourId);
+
+    const float yBottom = r.getBottom(), amp = r.getHeight();
+
+    g.setColour(grid.withAlpha(0.45f));
+    g.drawLine({r.getX(), yBottom, r.getRight(), yBottom}, 1.0f);
+
+    if (pyramid == nullptr || pyramid->numSamples() == 0)
+        return;
+
+    const auto &p = *pyramid;
+    const int n = p.numSamples();
+    const int cols = juce::jmax(1, (int)r.getWidth());
+
+    // Lane-1 cycle boundaries, when there is room to tell them apart
+    {
+        const double pxPerCycle = r.getWidth() / (viewLength * p.lengthCycles);
+        if (p.lengthCycles > 1.0 && pxPerCycle >= 8.0)
+        {
+            g.setColour(grid.withAlpha(0.25f));
+            const double first = std::ceil(viewStart * p.lengthCycles);
+            for (double c = first; c <= (viewStart + viewLength) * p.lengthCycles; c += 1.0)
+            {
+                const float x = r.getX() + (float)((c / p.lengthCycles - viewStart) / viewLength) * r.getWidth();
+                g.drawVerticalLine(juce::roundToInt(x), r.getY(), yBottom);
+            }
+        }
+    }
+
+    // Coarsest level whose bins are still no wider than a pixel
+    const double samplesPerCol = viewLength * (double)n / (double)cols;
+    const int level = juce::jlimit(0, p.numLevels() - 1, (int)std::floor(std::log2(juce::jmax(1.0, samplesPerCol))));
+    const auto &mins = p.mins[(size_t)level];
+    const auto &maxs = p.maxs[(size_t)level];
+    const int lastBin = (int)mins.size() - 1;
+
+    std::vector<float> colMin((size_t)cols), colMax((size_t)cols);
+    for (int x = 0; x < cols; ++x)
+    {
+        const double s0 = (viewStart + viewLength * (double)x / cols) * n;
+        const double s1 = (viewStart + viewLength * (double)(x + 1) / cols) * n;
+        const int b0 = juce::jlimit(0, lastBin, (int)std::floor(s0) >> level);
+        const int b1 = juce::jlimit(b0, lastBin, (juce::jmax((int)std::ceil(s1), 1) - 1) >> level);
+
+        float lo = mins[(size_t)b0], hi = maxs[(size_t)b0];
+        for (int b = b0 + 1; b <= b1; ++b)
+        {
+            lo = juce::jmin(lo, mins[(size_t)b]);
+            hi = juce::jmax(hi, maxs[(size_t)b]);
+        }
+        colMin[(size_t)x] = lo;
+        colMax[(size_t)x] = hi;
+    }
+
+    // Envelope: along the maxima, back along the minima
+    juce::Path band;
+    band.preallocateSpace(cols * 6 + 8);
+    for (int x = 0; x < cols; ++x)
+    {
+        const float px = r.getX() + (float)x + 0.5f;
+        const float py = yBottom - colMax[(size_t)x] * amp;
+        (x == 0 ? band.startNewSubPath(px, py) : band.lineTo(px, py));
+    }
+    for (int x = cols; --x >= 0;)
+        band.lineTo(r.getX() + (float)x + 0.5f, yBottom - colMin[(size_t)x] * amp);
+    band.closeSubPath();
+
+    g.setColour(wave.withAlpha(0.55f));
+    g.fillPath(band);
+    g.setColour(wave);
+    g.strokePath(band, juce::PathStrokeType(1.25f));
+
+    // Zoom readout
+    g.setColour(grid.withAlpha(0.9f));
+    g.setFont(juce::Font(juce::FontOptions(12.0f)));
+    juce::String info;
+    info << juce::String(p.lengthCycles, 3).trimCharactersAtEnd("0").trimCharactersAtEnd(".")
+         << (p.lengthCycles == 1.0 ? " cycle" : " cycles");
+    if (viewLength < 1.0)
+        info << "   x" << juce::String(1.0 / viewLength, 1);
+    g.drawText(info, r.removeFromTop(16.0f).reduced(4.0f, 0.0f), juce::Justification::topRight, false);
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Zoomable overview of the whole repeating output pattern.
+//
+// A background thread samples the mixed output once across the full pattern
+// (the least common multiple of the enabled lanes' cycles) and reduces it into
+// a min/max pyramid: level 0 holds the samples, every level above halves the
+// resolution. paint() reads the level whose bins are just finer than a pixel,
+// so zooming and scrolling never re-evaluate the engine.
+//
+// Wheel zooms around the mouse, drag scrolls, double-click shows everything.
+// ---------------------------------------------------------------------------
+class OverviewScope : public juce::Component,
+                      private juce::AsyncUpdater
+{
+public:
+    // Batch evaluator; phases are positions in the pattern, in lane-1 cycles
+    using Evaluator = std::function<void(const float *phases, float *out, int n)>;
+    // Current pattern length in lane-1 cycles (called on the builder thread)
+    using LengthFn = std::function<double()>;
+
+    OverviewScope();
+    ~OverviewScope() override;
+
+    void setSource(Evaluator evaluator, LengthFn patternLength);
+
+    // Parameters behind the evaluator changed. Rebuilds in the background; a
+    // scope that isn't on screen only remembers it until it is shown again.
+    void invalidate();
+
+    void paint(juce::Graphics &) override;
+
+    void mouseDown(const juce::MouseEvent &) override;
+    void mouseDrag(const juce::MouseEvent &) override;
+    void mouseDoubleClick(const juce::MouseEvent &) override;
+    void mouseWheelMove(const juce::MouseEvent &, const juce::MouseWheelDetails &) override;
+
+private:
+    struct Pyramid
+    {
+        double lengthCycles = 1.0;
+        std::vector<std::vector<float>> mins, maxs; // [level][bin]
+
+        int numSamples() const { return mins.empty() ? 0 : (int)mins.front().size(); }
+        int numLevels() const { return (int)mins.size(); }
+    };
+
+    class Builder : public juce::Thread
+    {
+    public:
+        explicit Builder(OverviewScope &o) : juce::Thread("pink eLFOnts overview"), owner(o) {}
+        void run() override;
+
+    private:
+        OverviewScope &owner;
+    };
+
+    // Builder thread: returns nullptr if a newer request arrived meanwhile
+    std::unique_ptr<Pyramid> build(int generation);
+
+    void handleAsyncUpdate() override;
+    void visibilityChanged() override;
+
+    juce::Rectangle<float> plotArea() const { return getLocalBounds().toFloat().reduced(8.0f, 6.0f); }
+
+    // Visible window as fractions of the pattern (0..1)
+    void setView(double start, double length);
+    double minViewLength() const;
+
+    Builder builder{*this};
+    std::atomic<int> requested{0}; // bumped per invalidate(); the builder chases it
+
+    juce::SpinLock sourceLock; // source: written on the message thread, read by the builder
+    Evaluator evaluator;
+    LengthFn patternLength;
+
+    juce::SpinLock pendingLock; // pending: written by the builder, taken on the message thread
+    std::unique_ptr<Pyramid> pending;
+
+    // Message thread only
+    std::unique_ptr<Pyramid> pyramid;
+    bool staleWhileHidden = true;
+    double viewStart = 0.0, viewLength = 1.0;
+    double dragStartView = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OverviewScope)
+};
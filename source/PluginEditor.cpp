@@ -7,16 +7,41 @@ namespace
     PinkLookAndFeel gPinkLAF;
 }
 
+static_assert(kMaxLaneTabs == PinkELFOntsAudioProcessor::numLanes, "one tab / mixer strip per plugin lane");
+
 // Layout
 namespace
 {
-    constexpr int kPad = 14;
-    constexpr int kGap = 10;
-    constexpr int kRowH = 44;
-    constexpr int kCardH = 220;
-    constexpr int kLaneH = 520; // room for full-size top row + one dual row
-    constexpr int kKnob = 100;  // full knob
-    constexpr int kDual = 88;   // dual knob size
+    // Design size (100 %); the editor keeps this aspect ratio when resized
+    constexpr int kBaseW = 980;
+    constexpr int kBaseH = 620;
+    constexpr float kMinScale = 0.75f;
+    constexpr float kMaxScale = 2.0f;
+
+    // Layout table at the current UI scale (everything is specified at 100 %)
+    struct Layout
+    {
+        explicit Layout(float s)
+            : scale(s), pad(px(14)), gap(px(10)), rowH(px(44)), cardH(px(220)),
+              laneH(px(520)), knob(px(100)), dual(px(88))
+        {
+        }
+
+        int px(float v) const { return juce::roundToInt(v * scale); }
+
+        float scale;
+        int pad;
+        int gap;
+        int rowH;
+        int cardH;
+        int laneH; // room for full-size top row + one dual row
+        int knob;  // full knob
+        int dual;  // dual knob size
+    };
+
+    // Hidden lane panels are destroyed after this long
+    constexpr int kPanelIdleCheckMs = 5000;
+    constexpr juce::uint32 kPanelIdleMs = 30000;
 }
 
 static void configSlider(juce::Slider &s, double min, double max, const juce::String &suf = {})
@@ -32,16 +57,403 @@ static void chainOnValue(juce::Slider &s, std::function<void()> extra)
     { if (prev) prev(); if (extra) extra(); };
 }
 
-bool PinkELFOntsAudioProcessorEditor::paramExists(const juce::String &id) const
+// ==================== LanePanel ====================
+
+namespace
+{
+    // Same travel / feel as the Knob and DualKnob sliders
+    constexpr float kRingStart = juce::MathConstants<float>::pi * 1.25f;
+    constexpr float kRingEnd = juce::MathConstants<float>::pi * 2.75f;
+    constexpr float kDragPixels = 250.0f; // juce::Slider's default full-range drag
+    constexpr float kWheelStep = 0.15f;
+}
+
+LanePanel::LanePanel(PinkELFOntsAudioProcessor &p, int laneNumber, ScopeWorker &worker,
+                     ScopeRepaintScheduler &s, std::function<void()> shapeChanged)
+    : processor(p), lane(laneNumber), scheduler(s), onShapeChanged(std::move(shapeChanged))
+{
+    auto &[phase, invertA, invertB, timeA, timeB, intensityA, intensityB] = controls;
+
+    phase.caption = "Phase";
+    bind(phase.outer, {"phaseDeg"});
+    invertA.caption = "Invert A";
+    bind(invertA.outer, {"invertA"});
+    invertB.caption = "Invert B";
+    bind(invertB.outer, {"invertB"});
+
+    // Time A/B: outer length mirrors rise + fall of that half
+    timeA.caption = "Time A / Curve 1";
+    timeA.dual = true;
+    bind(timeA.outer, {"curve.riseA", "curve.fallA"});
+    bind(timeA.inner, {"curv.riseA"});
+
+    timeB.caption = "Time B / Curve 2";
+    timeB.dual = true;
+    bind(timeB.outer, {"curve.riseB", "curve.fallB"});
+    bind(timeB.inner, {"curv.fallA"});
+
+    // Intensities: outer = amplitude per half, inner = remaining curvatures
+    intensityA.caption = "Intensity A / Curve 3";
+    intensityA.dual = true;
+    bind(intensityA.outer, {"intensityA"});
+    bind(intensityA.inner, {"curv.riseB"});
+
+    intensityB.caption = "Intensity B / Curve 4";
+    intensityB.dual = true;
+    bind(intensityB.outer, {"intensityB"});
+    bind(intensityB.inner, {"curv.fallB"});
+
+    // --- Division: named choice, or Free with the ratio below it ------------
+    const juce::String pfx = "lane" + juce::String(lane) + ".";
+    divisionBox.addItemList(processor.apvts.getParameter(pfx + "division")->getAllValueStrings(), 1);
+    for (int n = 1; n <= LfoEngine::maxRatio; ++n)
+    {
+        ratioNumBox.addItem(juce::String(n), n);
+        ratioDenBox.addItem(juce::String(n), n);
+    }
+    for (auto *box : {&divisionBox, &ratioNumBox, &ratioDenBox})
+    {
+        box->setJustificationType(juce::Justification::centred);
+        addAndMakeVisible(*box);
+    }
+    divisionAtt = std::make_unique<ComboAtt>(processor.apvts, pfx + "division", divisionBox);
+    ratioNumAtt = std::make_unique<ComboAtt>(processor.apvts, pfx + "ratioNum", ratioNumBox);
+    ratioDenAtt = std::make_unique<ComboAtt>(processor.apvts, pfx + "ratioDen", ratioDenBox);
+
+    // --- Scope: driven by the processor (DSP truth), ignoring phase nudge ---
+    scope.setWorker(&worker);
+    scope.setScheduler(&scheduler);
+    updateDivision();
+    scope.setEvaluator([this](const float *phases01, float *out, int n)
+                       { processor.evalLane(lane, phases01, out, n, false); });
+    addAndMakeVisible(scope);
+}
+
+LanePanel::~LanePanel()
+{
+    stopTimer();
+    scheduler.forget(scope);
+}
+
+void LanePanel::updateDivision()
+{
+    const auto division = processor.getLaneDivision(lane);
+    scope.setNumTriangles(division.triplet ? 3 : 2);
+    scope.setABTripletMode(division.triplet);
+    scheduler.markDirty(scope);
+
+    // The ratio only applies to "Free" (the last choice)
+    const bool isFree = divisionBox.getSelectedItemIndex() == divisionBox.getNumItems() - 1;
+    ratioNumBox.setEnabled(isFree);
+    ratioDenBox.setEnabled(isFree);
+}
+
+void LanePanel::bind(Ring &ring, std::initializer_list<const char *> paramSuffixes)
+{
+    const juce::String pfx = "lane" + juce::String(lane) + ".";
+
+    size_t slot = 0;
+    for (auto *suffix : paramSuffixes)
+    {
+        auto *param = processor.apvts.getParameter(pfx + suffix);
+        if (param == nullptr || slot >= ring.params.size())
+            continue;
+
+        ring.params[slot] = param;
+        ring.attachments[slot] = std::make_unique<juce::ParameterAttachment>(
+            *param, [this, &ring](float)
+            {
+                ring.value01 = ring.params[0]->getValue();
+                ringChanged(ring); });
+        ++slot;
+    }
+
+    if (ring.isBound())
+        ring.value01 = ring.params[0]->getValue();
+}
+
+void LanePanel::ringChanged(Ring &ring)
+{
+    repaint(areaOf(ring));
+
+    // Any ring on this lane: redraw our scope and the mixed output
+    scheduler.markDirty(scope);
+    if (onShapeChanged)
+        onShapeChanged();
+}
+
+juce::Rectangle<int> LanePanel::areaOf(const Ring &ring) const
+{
+    for (const auto &c : controls)
+        if (&c.outer == &ring || &c.inner == &ring)
+            return c.area;
+    return {};
+}
+
+LanePanel::Ring *LanePanel::ringAt(juce::Point<float> pos)
+{
+    // Inner ring sits on top of the outer one
+    for (auto &c : controls)
+    {
+        if (c.dual && c.inner.isBound() && c.inner.bounds.contains(pos))
+            return &c.inner;
+        if (c.outer.isBound() && c.outer.bounds.contains(pos))
+            return &c.outer;
+    }
+    return nullptr;
+}
+
+void LanePanel::setRingValue(Ring &ring, float value01)
+{
+    value01 = juce::jlimit(0.0f, 1.0f, value01);
+    for (size_t i = 0; i < ring.params.size(); ++i)
+        if (ring.attachments[i] != nullptr)
+            ring.attachments[i]->setValueAsPartOfGesture(ring.params[i]->convertFrom0to1(value01));
+}
+
+void LanePanel::beginGesture(Ring &ring)
+{
+    for (auto &att : ring.attachments)
+        if (att != nullptr)
+            att->beginGesture();
+}
+
+void LanePanel::endGesture(Ring &ring)
+{
+    for (auto &att : ring.attachments)
+        if (att != nullptr)
+            att->endGesture();
+}
+
+void LanePanel::mouseDown(const juce::MouseEvent &e)
+{
+    dragRing = ringAt(e.position);
+    if (dragRing == nullptr)
+        return;
+
+    dragStartValue01 = dragRing->value01;
+    beginGesture(*dragRing);
+    repaint(areaOf(*dragRing)); // value pill
+}
+
+void LanePanel::mouseDrag(const juce::MouseEvent &e)
+{
+    if (dragRing == nullptr)
+        return;
+
+    // RotaryHorizontalVerticalDrag: right / up increases; shift for fine moves
+    const auto offset = e.getOffsetFromDragStart();
+    const float fine = e.mods.isShiftDown() ? 0.1f : 1.0f;
+    setRingValue(*dragRing, dragStartValue01 + (float)(offset.x - offset.y) / kDragPixels * fine);
+}
+
+void LanePanel::mouseUp(const juce::MouseEvent &)
+{
+    if (dragRing == nullptr)
+        return;
+
+    endGesture(*dragRing);
+    repaint(areaOf(*dragRing));
+    dragRing = nullptr;
+}
+
+void LanePanel::mouseDoubleClick(const juce::MouseEvent &e)
+{
+    // Reset to the parameter default
+    if (auto *ring = ringAt(e.position))
+        for (size_t i = 0; i < ring->params.size(); ++i)
+            if (ring->attachments[i] != nullptr)
+                ring->attachments[i]->setValueAsCompleteGesture(
+                    ring->params[i]->convertFrom0to1(ring->params[i]->getDefaultValue()));
+}
+
+void LanePanel::mouseWheelMove(const juce::MouseEvent &e, const juce::MouseWheelDetails &wheel)
+{
+    auto *ring = ringAt(e.position);
+    if (ring == nullptr)
+    {
+        juce::Component::mouseWheelMove(e, wheel);
+        return;
+    }
+
+    const float delta = (wheel.deltaX != 0.0f ? -wheel.deltaX : wheel.deltaY) * (wheel.isReversed ? -1.0f : 1.0f);
+    beginGesture(*ring);
+    setRingValue(*ring, ring->value01 + delta * kWheelStep);
+    endGesture(*ring);
+}
+
+void LanePanel::renderStaticLayer(float scale)
+{
+    staticLayerScale = scale;
+    staticLayer = juce::Image(juce::Image::ARGB,
+                              juce::jmax(1, juce::roundToInt((float)getWidth() * scale)),
+                              juce::jmax(1, juce::roundToInt((float)getHeight() * scale)), true);
+
+    juce::Graphics g(staticLayer);
+    g.addTransform(juce::AffineTransform::scale(scale));
+
+    const Layout L(uiScale);
+    const auto back = findColour(juce::Slider::backgroundColourId);
+    g.setFont(juce::Font(juce::FontOptions(15.0f * uiScale)));
+
+    for (const auto &c : controls)
+    {
+        // caption (as the Knob / DualKnob label)
+        g.setColour(juce::Colour(0xFF9AA7B8));
+        g.drawFittedText(c.caption, c.area.withHeight(L.px(16)).reduced(L.px(5), 1), juce::Justification::centred, 1);
+
+        PinkLookAndFeel::drawKnobFace(g, c.outer.bounds, back);
+        if (c.dual)
+            PinkLookAndFeel::drawKnobFace(g, c.inner.bounds, back);
+    }
+
+    // Division caption, and the ratio's separator between its two boxes
+    g.setColour(juce::Colour(0xFF9AA7B8));
+    g.drawFittedText("Division", divisionArea.withHeight(L.px(16)).reduced(L.px(5), 1), juce::Justification::centred, 1);
+    g.drawFittedText(":", ratioNumBox.getBounds().getUnion(ratioDenBox.getBounds()), juce::Justification::centred, 1);
+}
+
+void LanePanel::paint(juce::Graphics &g)
+{
+    PLF_PROFILE_UI("LanePanel::paint");
+
+    // Static layer is keyed by the display scale; while a resize is in flight
+    // the previous one is stretched instead of re-rendered every step
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (staticLayer.isNull() || staticLayerScale != scale)
+    {
+        renderStaticLayer(scale);
+        staticLayerStale = false;
+    }
+
+    if (staticLayerStale)
+        g.drawImage(staticLayer, getLocalBounds().toFloat());
+    else
+        g.drawImageTransformed(staticLayer, juce::AffineTransform::scale(1.0f / scale));
+
+    // Dynamic part: arcs, thumbs and the value pill
+    const auto track = findColour(juce::Slider::trackColourId);
+    const auto thumb = findColour(juce::Slider::thumbColourId);
+
+    for (const auto &c : controls)
+    {
+        if (!g.clipRegionIntersects(c.area))
+            continue;
+
+        PinkLookAndFeel::drawKnobValue(g, c.outer.bounds, c.outer.value01, kRingStart, kRingEnd, track, thumb);
+        if (c.dual)
+            PinkLookAndFeel::drawKnobValue(g, c.inner.bounds, c.inner.value01, kRingStart, kRingEnd, track, thumb);
+
+        // value pill while a single knob is dragged
+        if (!c.dual && dragRing == &c.outer && c.outer.isBound())
+        {
+            const float v = c.outer.params[0]->convertFrom0to1(c.outer.value01);
+            g.setColour(juce::Colour(0xFFE6EBF2));
+            g.setFont(juce::Font(juce::FontOptions(15.0f * uiScale)));
+            const int pillH = juce::roundToInt(18.0f * uiScale);
+            g.drawFittedText(juce::String(v, 2), c.area.withTrimmedTop(c.area.getHeight() - pillH).reduced(pillH / 2, 2),
+                             juce::Justification::centred, 1);
+        }
+    }
+}
+
+void LanePanel::setUiScale(float newScale)
+{
+    if (newScale == uiScale)
+        return;
+
+    uiScale = newScale;
+    resized();
+}
+
+void LanePanel::timerCallback()
 {
-    return processor.apvts.getParameter(id) != nullptr;
+    // Resize has settled: re-render the static layer at the final size
+    stopTimer();
+    staticLayer = {};
+    staticLayerStale = false;
+    repaint();
 }
 
+void LanePanel::resized()
+{
+    PLF_PROFILE_UI("LanePanel::resized");
+
+    // Keep stretching the old static layer until the size settles
+    if (!staticLayer.isNull())
+    {
+        staticLayerStale = true;
+        startTimer((int)ScopeRepaintScheduler::resizeSettleMs);
+    }
+
+    const Layout L(uiScale);
+    auto r = getLocalBounds();
+
+    // Left controls / Right scope
+    const int cols = 4;
+    const int colW = L.dual;
+    const int colGap = L.gap;
+    const int gridW = cols * colW + (cols - 1) * colGap;
+
+    auto grid = r.removeFromLeft(gridW + L.px(4));
+    scope.setBounds(r.reduced(L.px(8), L.px(6)));
+
+    // ---------------- Row 0: Division | Phase | Invert A | Invert B ----------
+    auto row0 = grid.removeFromTop(L.knob);
+    divisionArea = row0.removeFromLeft(colW);
+    row0.removeFromLeft(colGap);
+    {
+        auto d = divisionArea.withTrimmedTop(L.px(20));
+        const int boxH = L.px(26);
+        divisionBox.setBounds(d.removeFromTop(boxH));
+        d.removeFromTop(L.px(8));
+        auto ratioRow = d.removeFromTop(boxH);
+        const int boxW = (ratioRow.getWidth() - L.px(12)) / 2;
+        ratioNumBox.setBounds(ratioRow.removeFromLeft(boxW));
+        ratioDenBox.setBounds(ratioRow.removeFromRight(boxW));
+    }
+    for (size_t i = 0; i < 3; ++i)
+    {
+        auto &c = controls[i];
+        c.area = row0.removeFromLeft(colW);
+        row0.removeFromLeft(colGap);
+
+        // Knob: caption on top, value pill at the bottom
+        c.outer.bounds = c.area.withTrimmedTop(L.px(16)).withTrimmedBottom(L.px(18)).reduced(L.px(8)).toFloat();
+    }
+
+    grid.removeFromTop(L.gap);
+
+    // ------ Row 1: Time A | Time B | Intensity A | Intensity B ----------
+    auto rowDual = grid.removeFromTop(L.dual);
+    for (size_t i = 3; i < controls.size(); ++i)
+    {
+        auto &c = controls[i];
+        c.area = rowDual.removeFromLeft(colW);
+        rowDual.removeFromLeft(colGap);
+
+        // DualKnob: inner ring ~54% of the outer
+        const auto outer = c.area.withTrimmedTop(L.px(16)).reduced(L.px(6));
+        c.outer.bounds = outer.toFloat();
+        c.inner.bounds = outer.withSizeKeepingCentre(int(outer.getWidth() * 0.54f),
+                                                     int(outer.getHeight() * 0.54f))
+                             .toFloat();
+    }
+}
+
+// ==================== Editor ====================
+
 PinkELFOntsAudioProcessorEditor::PinkELFOntsAudioProcessorEditor(PinkELFOntsAudioProcessor &p)
     : juce::AudioProcessorEditor(&p), processor(p)
 {
     setLookAndFeel(&gPinkLAF);
-    setSize(980, 620);
+
+    // Resizable with a fixed aspect ratio; the layout scales with the width
+    setResizable(true, true);
+    setResizeLimits(juce::roundToInt(kBaseW * kMinScale), juce::roundToInt(kBaseH * kMinScale),
+                    juce::roundToInt(kBaseW * kMaxScale), juce::roundToInt(kBaseH * kMaxScale));
+    getConstrainer()->setFixedAspectRatio((double)kBaseW / (double)kBaseH);
+    setSize(kBaseW, kBaseH);
 
     // --- Top bar ------------------------------------------------------------
     title.setText("pink eLFOnts", juce::dontSendNotification);
@@ -54,6 +466,31 @@ PinkELFOntsAudioProcessorEditor::PinkELFOntsAudioProcessorEditor(PinkELFOntsAudi
     addAndMakeVisible(retrigBox);
     retrigAtt = std::make_unique<ComboAtt>(processor.apvts, "global.retrig", retrigBox);
 
+    // Lane count: "1 lane" .. "16 lanes" (items in parameter order)
+    for (int n = 1; n <= kMaxLaneTabs; ++n)
+        lanesBox.addItem(juce::String(n) + (n == 1 ? " lane" : " lanes"), n);
+    lanesBox.setJustificationType(juce::Justification::centred);
+    addAndMakeVisible(lanesBox);
+    lanesAtt = std::make_unique<ComboAtt>(processor.apvts, "global.numLanes", lanesBox);
+
+    // --- Presets ------------------------------------------------------------
+    presetBox.setTextWhenNothingSelected("Presets");
+    presetBox.setTextWhenNoChoicesAvailable("No presets");
+    presetBox.onChange = [this]
+    {
+        const int idx = presetBox.getSelectedId() - 1;
+        if (idx >= 0 && idx != processor.presets.getCurrentIndex())
+            processor.presets.apply(idx);
+    };
+    addAndMakeVisible(presetBox);
+
+    savePresetBtn.onClick = [this]
+    { savePresetPrompt(); };
+    addAndMakeVisible(savePresetBtn);
+
+    processor.presets.addChangeListener(this);
+    refreshPresetBox();
+
     // --- Sections -----------------------------------------------------------
     addAndMakeVisible(secOutput);
     addAndMakeVisible(secLane);
@@ -62,10 +499,11 @@ PinkELFOntsAudioProcessorEditor::PinkELFOntsAudioProcessorEditor(PinkELFOntsAudi
     // --- Mixer card (top-right) ------------------------------------------------
     addAndMakeVisible(secMixer);
 
-    // Build 8 columns: label, fader (0..1), mute (laneX.enabled)
-    for (int i = 0; i < 8; ++i)
+    // One column per lane: label, fader (0..1), mute (laneX.enabled); only the
+    // active lanes' columns are shown (updateLaneTabs)
+    for (int i = 0; i < kMaxLaneTabs; ++i)
     {
-        // Label "L1..L8"
+        // Label "L1..L16"
         mixerLbl[i].setText("L" + juce::String(i + 1), juce::dontSendNotification);
         mixerLbl[i].setJustificationType(juce::Justification::centred);
         mixerLbl[i].setColour(juce::Label::textColourId, juce::Colour(0xFFE6EBF2));
@@ -79,7 +517,7 @@ PinkELFOntsAudioProcessorEditor::PinkELFOntsAudioProcessorEditor(PinkELFOntsAudi
         f.setDoubleClickReturnValue(true, 1.0);
         addAndMakeVisible(f);
 
-        // Attach to laneX.mix if present (X=1..8)
+        // Attach to laneX.mix if present
         const juce::String mixId = "lane" + juce::String(i + 1) + ".mix";
         if (processor.apvts.getParameter(mixId) != nullptr)
             mixerFaderAtt[i] = std::make_unique<SliderAtt>(processor.apvts, mixId, f);
@@ -93,18 +531,14 @@ PinkELFOntsAudioProcessorEditor::PinkELFOntsAudioProcessorEditor(PinkELFOntsAudi
         const juce::String enId = "lane" + juce::String(i + 1) + ".enabled";
         if (processor.apvts.getParameter(enId) != nullptr)
             mixerOnAtt[i] = std::make_unique<ButtonAtt>(processor.apvts, enId, m);
+
+        // Contribution meter beside the fader
+        addAndMakeVisible(mixerMeter[i]);
     }
 
-    // --- Tabs ---------------------------------------------------------------
+    // --- Tabs (one per active lane, titled by its division, then Overview;
+    //     added by updateLaneTabs() once everything else is set up) ---------
     addAndMakeVisible(laneTabs);
-    laneTabs.addTab("Lane 1 (1/4)", juce::Colours::transparentBlack, nullptr, false);
-    laneTabs.addTab("Lane 2 (1/4T)", juce::Colours::transparentBlack, nullptr, false);
-    laneTabs.addTab("Lane 3 (1/8)", juce::Colours::transparentBlack, nullptr, false);
-    laneTabs.addTab("Lane 4 (1/8T)", juce::Colours::transparentBlack, nullptr, false);
-    laneTabs.addTab("Lane 5 (1/16)", juce::Colours::transparentBlack, nullptr, false);
-    laneTabs.addTab("Lane 6 (1/16T)", juce::Colours::transparentBlack, nullptr, false);
-    laneTabs.addTab("Lane 7 (1/32)", juce::Colours::transparentBlack, nullptr, false);
-    laneTabs.addTab("Lane 8 (1/32T)", juce::Colours::transparentBlack, nullptr, false);
     laneTabs.getTabbedButtonBar().setColour(juce::TabbedButtonBar::tabTextColourId, juce::Colour(0xFFE6EBF2));
     laneTabs.getTabbedButtonBar().addChangeListener(this);
 
@@ -150,605 +584,30 @@ PinkELFOntsAudioProcessorEditor::PinkELFOntsAudioProcessorEditor(PinkELFOntsAudi
     slopeLenAtt = std::make_unique<SliderAtt>(processor.apvts, "output.slope", slopeK.length);
     slopeCurveAtt = std::make_unique<SliderAtt>(processor.apvts, "output.slopeCurve", slopeK.curve);
 
-    // --- LANE 1 controls ----------------------------------------------------
-    addAndMakeVisible(phaseK1);
-    configSlider(phaseK1.slider, 0.0, 360.0, "°");
-    phase1Att = std::make_unique<SliderAtt>(processor.apvts, "lane1.phaseDeg", phaseK1.slider);
-
-    addAndMakeVisible(invertA1);
-    configSlider(invertA1.slider, -1.0, 1.0, "");
-    addAndMakeVisible(invertB1);
-    configSlider(invertB1.slider, -1.0, 1.0, "");
-
-    addAndMakeVisible(timeA1);
-    configSlider(timeA1.length, 0.25, 4.0, "");
-    configSlider(timeA1.curve, -1.0, 1.0, "");
-
-    addAndMakeVisible(timeB1);
-    configSlider(timeB1.length, 0.25, 4.0, "");
-    configSlider(timeB1.curve, -1.0, 1.0, "");
-
-    addAndMakeVisible(intensityA1);
-    configSlider(intensityA1.length, 0.0, 1.0, "");
-    configSlider(intensityA1.curve, -1.0, 1.0, "");
-
-    addAndMakeVisible(intensityB1);
-    configSlider(intensityB1.length, 0.0, 1.0, "");
-    configSlider(intensityB1.curve, -1.0, 1.0, "");
-
-    // Double-click resets
-    for (auto *s : {&invertA1.slider, &invertB1.slider})
-        s->setDoubleClickReturnValue(true, 0.0);
-    for (auto *s : {&timeA1.curve, &timeB1.curve, &intensityA1.curve, &intensityB1.curve})
-        s->setDoubleClickReturnValue(true, 0.0);
-    phaseK1.slider.setDoubleClickReturnValue(true, 0.0);
-
-    // --- Attach to APVTS (lane 1) ----------------------------------------------
-    // Phase / invert
-    phase1Att = std::make_unique<SliderAtt>(processor.apvts, "lane1.phaseDeg", phaseK1.slider);
-    invertA1Att = std::make_unique<SliderAtt>(processor.apvts, "lane1.invertA", invertA1.slider);
-    invertB1Att = std::make_unique<SliderAtt>(processor.apvts, "lane1.invertB", invertB1.slider);
-
-    // Time A replaces (riseA + fallA): drive both lengths + both curvature params
-    timeA1LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane1.riseA", timeA1.length);
-    timeA1LenFallAtt = std::make_unique<SliderAtt>(processor.apvts, "lane1.curve.fallA", timeA1.length); // mirror
-    timeA1CurveRiseAtt = std::make_unique<SliderAtt>(processor.apvts, "lane1.curv.riseA", timeA1.curve);
-
-    // Time B replaces (riseB + fallB)
-    timeB1LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane1riseB", timeB1.length);
-    timeB1LenFallAtt = std::make_unique<SliderAtt>(processor.apvts, "lane1.curve.fallB", timeB1.length); // mirror
-    timeB1CurveRiseAtt = std::make_unique<SliderAtt>(processor.apvts, "lane1.curv.fallA", timeB1.curve);
-
-    // Intensities: outer length = amplitude per half; inner curve drives only the FALL edge
-    intensityA1LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane1.intensityA", intensityA1.length);
-    intensityA1CurveAtt = std::make_unique<SliderAtt>(processor.apvts, "lane1.curv.riseB", intensityA1.curve);
-
-    intensityB1LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane1.intensityB", intensityB1.length);
-    intensityB1CurveAtt = std::make_unique<SliderAtt>(processor.apvts, "lane1.curv.fallB", intensityB1.curve);
-
-    // --- LANE 2 controls ----------------------------------------------------
-    addAndMakeVisible(phaseK2);
-    configSlider(phaseK2.slider, 0.0, 360.0, "°");
-    if (paramExists("lane2.phaseDeg"))
-        phase2Att = std::make_unique<SliderAtt>(processor.apvts, "lane2.phaseDeg", phaseK2.slider);
-
-    addAndMakeVisible(invertA2);
-    configSlider(invertA2.slider, -1.0, 1.0, "");
-    addAndMakeVisible(invertB2);
-    configSlider(invertB2.slider, -1.0, 1.0, "");
-    if (paramExists("lane2.invertA"))
-        invertA2Att = std::make_unique<SliderAtt>(processor.apvts, "lane2.invertA", invertA2.slider);
-    if (paramExists("lane2.invertB"))
-        invertB2Att = std::make_unique<SliderAtt>(processor.apvts, "lane2.invertB", invertB2.slider);
-
-    addAndMakeVisible(timeA2);
-    configSlider(timeA2.length, 0.25, 4.0, "");
-    configSlider(timeA2.curve, -1.0, 1.0, "");
-    addAndMakeVisible(timeB2);
-    configSlider(timeB2.length, 0.25, 4.0, "");
-    configSlider(timeB2.curve, -1.0, 1.0, "");
-
-    addAndMakeVisible(intensityA2);
-    configSlider(intensityA2.length, 0.0, 1.0, "");
-    configSlider(intensityA2.curve, -1.0, 1.0, "");
-    addAndMakeVisible(intensityB2);
-    configSlider(intensityB2.length, 0.0, 1.0, "");
-    configSlider(intensityB2.curve, -1.0, 1.0, "");
-
-    // Double-click resets
-    for (auto *s : {&invertA2.slider, &invertB2.slider})
-        s->setDoubleClickReturnValue(true, 0.0);
-    for (auto *s : {&timeA2.curve, &timeB2.curve, &intensityA2.curve, &intensityB2.curve})
-        s->setDoubleClickReturnValue(true, 0.0);
-    phaseK2.slider.setDoubleClickReturnValue(true, 0.0);
-
-    // --- Attach to APVTS (lane 2) ------------------------------------------
-    timeA2LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane2.riseA", timeA2.length);
-    timeA2LenFallAtt = std::make_unique<SliderAtt>(processor.apvts, "lane2.curve.fallA", timeA2.length); // mirror length
-    timeA2CurveRiseAtt = std::make_unique<SliderAtt>(processor.apvts, "lane2.curv.riseA", timeA2.curve);
-
-    timeB2LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane2.riseB", timeB2.length);
-    timeB2LenFallAtt = std::make_unique<SliderAtt>(processor.apvts, "lane2.curve.fallB", timeB2.length); // mirror length
-    timeB2CurveRiseAtt = std::make_unique<SliderAtt>(processor.apvts, "lane2.curv.fallA", timeB2.curve);
-
-    intensityA2LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane2.intensityA", intensityA2.length);
-    intensityA2CurveAtt = std::make_unique<SliderAtt>(processor.apvts, "lane2.curv.riseB", intensityA2.curve);
-
-    intensityB2LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane2.intensityB", intensityB2.length);
-    intensityB2CurveAtt = std::make_unique<SliderAtt>(processor.apvts, "lane2.curv.fallB", intensityB2.curve);
-
-    // --- LANE 3 controls ----------------------------------------------------
-    addAndMakeVisible(phaseK3);
-    configSlider(phaseK3.slider, 0.0, 360.0, "°");
-    if (paramExists("lane3.phaseDeg"))
-        phase3Att = std::make_unique<SliderAtt>(processor.apvts, "lane3.phaseDeg", phaseK3.slider);
-
-    addAndMakeVisible(invertA3);
-    configSlider(invertA3.slider, -1.0, 1.0, "");
-    addAndMakeVisible(invertB3);
-    configSlider(invertB3.slider, -1.0, 1.0, "");
-    if (paramExists("lane3.invertA"))
-        invertA3Att = std::make_unique<SliderAtt>(processor.apvts, "lane3.invertA", invertA3.slider);
-    if (paramExists("lane3.invertB"))
-        invertB3Att = std::make_unique<SliderAtt>(processor.apvts, "lane3.invertB", invertB3.slider);
-
-    addAndMakeVisible(timeA3);
-    configSlider(timeA3.length, 0.25, 4.0, "");
-    configSlider(timeA3.curve, -1.0, 1.0, "");
-    addAndMakeVisible(timeB3);
-    configSlider(timeB3.length, 0.25, 4.0, "");
-    configSlider(timeB3.curve, -1.0, 1.0, "");
-
-    addAndMakeVisible(intensityA3);
-    configSlider(intensityA3.length, 0.0, 1.0, "");
-    configSlider(intensityA3.curve, -1.0, 1.0, "");
-    addAndMakeVisible(intensityB3);
-    configSlider(intensityB3.length, 0.0, 1.0, "");
-    configSlider(intensityB3.curve, -1.0, 1.0, "");
-
-    // Double-click resets
-    for (auto *s : {&invertA3.slider, &invertB3.slider})
-        s->setDoubleClickReturnValue(true, 0.0);
-    for (auto *s : {&timeA3.curve, &timeB3.curve, &intensityA3.curve, &intensityB3.curve})
-        s->setDoubleClickReturnValue(true, 0.0);
-    phaseK3.slider.setDoubleClickReturnValue(true, 0.0);
-
-    // --- Attach to APVTS (lane 3) ------------------------------------------
-    timeA3LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane3.riseA", timeA3.length);
-    timeA3LenFallAtt = std::make_unique<SliderAtt>(processor.apvts, "lane3.curve.fallA", timeA3.length);
-    timeA3CurveRiseAtt = std::make_unique<SliderAtt>(processor.apvts, "lane3.curv.riseA", timeA3.curve);
-
-    timeB3LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane3.riseB", timeB3.length);
-    timeB3LenFallAtt = std::make_unique<SliderAtt>(processor.apvts, "lane3.curve.fallB", timeB3.length);
-    timeB3CurveRiseAtt = std::make_unique<SliderAtt>(processor.apvts, "lane3.curv.fallA", timeB3.curve);
-
-    intensityA3LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane3.intensityA", intensityA3.length);
-    intensityA3CurveAtt = std::make_unique<SliderAtt>(processor.apvts, "lane3.curv.riseB", intensityA3.curve);
-
-    intensityB3LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane3.intensityB", intensityB3.length);
-    intensityB3CurveAtt = std::make_unique<SliderAtt>(processor.apvts, "lane3.curv.fallB", intensityB3.curve);
-
-    // --- LANE 4 controls ----------------------------------------------------
-    addAndMakeVisible(phaseK4);
-    configSlider(phaseK4.slider, 0.0, 360.0, "°");
-    if (paramExists("lane4.phaseDeg"))
-        phase4Att = std::make_unique<SliderAtt>(processor.apvts, "lane4.phaseDeg", phaseK4.slider);
-
-    addAndMakeVisible(invertA4);
-    configSlider(invertA4.slider, -1.0, 1.0, "");
-    addAndMakeVisible(invertB4);
-    configSlider(invertB4.slider, -1.0, 1.0, "");
-    if (paramExists("lane4.invertA"))
-        invertA4Att = std::make_unique<SliderAtt>(processor.apvts, "lane4.invertA", invertA4.slider);
-    if (paramExists("lane4.invertB"))
-        invertB4Att = std::make_unique<SliderAtt>(processor.apvts, "lane4.invertB", invertB4.slider);
-
-    addAndMakeVisible(timeA4);
-    configSlider(timeA4.length, 0.25, 4.0, "");
-    configSlider(timeA4.curve, -1.0, 1.0, "");
-    addAndMakeVisible(timeB4);
-    configSlider(timeB4.length, 0.25, 4.0, "");
-    configSlider(timeB4.curve, -1.0, 1.0, "");
-
-    addAndMakeVisible(intensityA4);
-    configSlider(intensityA4.length, 0.0, 1.0, "");
-    configSlider(intensityA4.curve, -1.0, 1.0, "");
-    addAndMakeVisible(intensityB4);
-    configSlider(intensityB4.length, 0.0, 1.0, "");
-    configSlider(intensityB4.curve, -1.0, 1.0, "");
-
-    // Double-click resets
-    for (auto *s : {&invertA4.slider, &invertB4.slider})
-        s->setDoubleClickReturnValue(true, 0.0);
-    for (auto *s : {&timeA4.curve, &timeB4.curve, &intensityA4.curve, &intensityB4.curve})
-        s->setDoubleClickReturnValue(true, 0.0);
-    phaseK4.slider.setDoubleClickReturnValue(true, 0.0);
-
-    // --- Attach to APVTS (lane 4) ------------------------------------------
-    timeA4LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane4.riseA", timeA4.length);
-    timeA4LenFallAtt = std::make_unique<SliderAtt>(processor.apvts, "lane4.curve.fallA", timeA4.length);
-    timeA4CurveRiseAtt = std::make_unique<SliderAtt>(processor.apvts, "lane4.curv.riseA", timeA4.curve);
-
-    timeB4LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane4.riseB", timeB4.length);
-    timeB4LenFallAtt = std::make_unique<SliderAtt>(processor.apvts, "lane4.curve.fallB", timeB4.length);
-    timeB4CurveRiseAtt = std::make_unique<SliderAtt>(processor.apvts, "lane4.curv.fallA", timeB4.curve);
-
-    intensityA4LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane4.intensityA", intensityA4.length);
-    intensityA4CurveAtt = std::make_unique<SliderAtt>(processor.apvts, "lane4.curv.riseB", intensityA4.curve);
-
-    intensityB4LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane4.intensityB", intensityB4.length);
-    intensityB4CurveAtt = std::make_unique<SliderAtt>(processor.apvts, "lane4.curv.fallB", intensityB4.curve);
-
-    // --- LANE 5 controls ----------------------------------------------------
-    addAndMakeVisible(phaseK5);
-    configSlider(phaseK5.slider, 0.0, 360.0, "°");
-    if (paramExists("lane5.phaseDeg"))
-        phase5Att = std::make_unique<SliderAtt>(processor.apvts, "lane5.phaseDeg", phaseK5.slider);
-
-    addAndMakeVisible(invertA5);
-    configSlider(invertA5.slider, -1.0, 1.0, "");
-    addAndMakeVisible(invertB5);
-    configSlider(invertB5.slider, -1.0, 1.0, "");
-    if (paramExists("lane5.invertA"))
-        invertA5Att = std::make_unique<SliderAtt>(processor.apvts, "lane5.invertA", invertA5.slider);
-    if (paramExists("lane5.invertB"))
-        invertB5Att = std::make_unique<SliderAtt>(processor.apvts, "lane5.invertB", invertB5.slider);
-
-    addAndMakeVisible(timeA5);
-    configSlider(timeA5.length, 0.25, 4.0, "");
-    configSlider(timeA5.curve, -1.0, 1.0, "");
-    addAndMakeVisible(timeB5);
-    configSlider(timeB5.length, 0.25, 4.0, "");
-    configSlider(timeB5.curve, -1.0, 1.0, "");
-
-    addAndMakeVisible(intensityA5);
-    configSlider(intensityA5.length, 0.0, 1.0, "");
-    configSlider(intensityA5.curve, -1.0, 1.0, "");
-    addAndMakeVisible(intensityB5);
-    configSlider(intensityB5.length, 0.0, 1.0, "");
-    configSlider(intensityB5.curve, -1.0, 1.0, "");
-
-    // Double-click resets
-    for (auto *s : {&invertA5.slider, &invertB5.slider})
-        s->setDoubleClickReturnValue(true, 0.0);
-    for (auto *s : {&timeA5.curve, &timeB5.curve, &intensityA5.curve, &intensityB5.curve})
-        s->setDoubleClickReturnValue(true, 0.0);
-    phaseK5.slider.setDoubleClickReturnValue(true, 0.0);
-
-    // --- Attach to APVTS (lane 5) ------------------------------------------
-    timeA5LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane5.riseA", timeA5.length);
-    timeA5LenFallAtt = std::make_unique<SliderAtt>(processor.apvts, "lane5.curve.fallA", timeA5.length);
-    timeA5CurveRiseAtt = std::make_unique<SliderAtt>(processor.apvts, "lane5.curv.riseA", timeA5.curve);
-
-    timeB5LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane5.riseB", timeB5.length);
-    timeB5LenFallAtt = std::make_unique<SliderAtt>(processor.apvts, "lane5.curve.fallB", timeB5.length);
-    timeB5CurveRiseAtt = std::make_unique<SliderAtt>(processor.apvts, "lane5.curv.fallA", timeB5.curve);
-
-    intensityA5LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane5.intensityA", intensityA5.length);
-    intensityA5CurveAtt = std::make_unique<SliderAtt>(processor.apvts, "lane5.curv.riseB", intensityA5.curve);
-
-    intensityB5LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane5.intensityB", intensityB5.length);
-    intensityB5CurveAtt = std::make_unique<SliderAtt>(processor.apvts, "lane5.curv.fallB", intensityB5.curve);
-
-    // --- LANE 6 controls ----------------------------------------------------
-    addAndMakeVisible(phaseK6);
-    configSlider(phaseK6.slider, 0.0, 360.0, "°");
-    if (paramExists("lane6.phaseDeg"))
-        phase6Att = std::make_unique<SliderAtt>(processor.apvts, "lane6.phaseDeg", phaseK6.slider);
-
-    addAndMakeVisible(invertA6);
-    configSlider(invertA6.slider, -1.0, 1.0, "");
-    addAndMakeVisible(invertB6);
-    configSlider(invertB6.slider, -1.0, 1.0, "");
-    if (paramExists("lane6.invertA"))
-        invertA6Att = std::make_unique<SliderAtt>(processor.apvts, "lane6.invertA", invertA6.slider);
-    if (paramExists("lane6.invertB"))
-        invertB6Att = std::make_unique<SliderAtt>(processor.apvts, "lane6.invertB", invertB6.slider);
-
-    addAndMakeVisible(timeA6);
-    configSlider(timeA6.length, 0.25, 4.0, "");
-    configSlider(timeA6.curve, -1.0, 1.0, "");
-    addAndMakeVisible(timeB6);
-    configSlider(timeB6.length, 0.25, 4.0, "");
-    configSlider(timeB6.curve, -1.0, 1.0, "");
-
-    addAndMakeVisible(intensityA6);
-    configSlider(intensityA6.length, 0.0, 1.0, "");
-    configSlider(intensityA6.curve, -1.0, 1.0, "");
-    addAndMakeVisible(intensityB6);
-    configSlider(intensityB6.length, 0.0, 1.0, "");
-    configSlider(intensityB6.curve, -1.0, 1.0, "");
-
-    // Double-click resets
-    for (auto *s : {&invertA6.slider, &invertB6.slider})
-        s->setDoubleClickReturnValue(true, 0.0);
-    for (auto *s : {&timeA6.curve, &timeB6.curve, &intensityA6.curve, &intensityB6.curve})
-        s->setDoubleClickReturnValue(true, 0.0);
-    phaseK6.slider.setDoubleClickReturnValue(true, 0.0);
-
-    // --- Attach to APVTS (lane 6) ------------------------------------------
-    timeA6LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane6.riseA", timeA6.length);
-    timeA6LenFallAtt = std::make_unique<SliderAtt>(processor.apvts, "lane6.curve.fallA", timeA6.length);
-    timeA6CurveRiseAtt = std::make_unique<SliderAtt>(processor.apvts, "lane6.curv.riseA", timeA6.curve);
-
-    timeB6LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane6.riseB", timeB6.length);
-    timeB6LenFallAtt = std::make_unique<SliderAtt>(processor.apvts, "lane6.curve.fallB", timeB6.length);
-    timeB6CurveRiseAtt = std::make_unique<SliderAtt>(processor.apvts, "lane6.curv.fallA", timeB6.curve);
-
-    intensityA6LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane6.intensityA", intensityA6.length);
-    intensityA6CurveAtt = std::make_unique<SliderAtt>(processor.apvts, "lane6.curv.riseB", intensityA6.curve);
-
-    intensityB6LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane6.intensityB", intensityB6.length);
-    intensityB6CurveAtt = std::make_unique<SliderAtt>(processor.apvts, "lane6.curv.fallB", intensityB6.curve);
-
-    // --- LANE 7 controls ----------------------------------------------------
-    addAndMakeVisible(phaseK7);
-    configSlider(phaseK7.slider, 0.0, 360.0, "°");
-
-    addAndMakeVisible(invertA7);
-    configSlider(invertA7.slider, -1.0, 1.0, "");
-    addAndMakeVisible(invertB7);
-    configSlider(invertB7.slider, -1.0, 1.0, "");
-
-    addAndMakeVisible(timeA7);
-    configSlider(timeA7.length, 0.25, 4.0, "");
-    configSlider(timeA7.curve, -1.0, 1.0, "");
-
-    addAndMakeVisible(timeB7);
-    configSlider(timeB7.length, 0.25, 4.0, "");
-    configSlider(timeB7.curve, -1.0, 1.0, "");
-
-    addAndMakeVisible(intensityA7);
-    configSlider(intensityA7.length, 0.0, 1.0, "");
-    configSlider(intensityA7.curve, -1.0, 1.0, "");
-
-    addAndMakeVisible(intensityB7);
-    configSlider(intensityB7.length, 0.0, 1.0, "");
-    configSlider(intensityB7.curve, -1.0, 1.0, "");
-
-    addAndMakeVisible(lane7Scope2);
-
-    // Double-click resets (match other lanes)
-    for (auto *s : {&invertA7.slider, &invertB7.slider})
-        s->setDoubleClickReturnValue(true, 0.0);
-    for (auto *s : {&timeA7.curve, &timeB7.curve, &intensityA7.curve, &intensityB7.curve})
-        s->setDoubleClickReturnValue(true, 0.0);
-    phaseK7.slider.setDoubleClickReturnValue(true, 0.0);
-
-    // --- Attach to APVTS (lane 7) -------------------------------------------
-    phase7Att = std::make_unique<SliderAtt>(processor.apvts, "lane7.phaseDeg", phaseK7.slider);
-    invertA7Att = std::make_unique<SliderAtt>(processor.apvts, "lane7.invertA", invertA7.slider);
-    invertB7Att = std::make_unique<SliderAtt>(processor.apvts, "lane7.invertB", invertB7.slider);
-
-    // Time A: outer length mirrors riseA & fallA; inner curve drives curv.riseA
-    timeA7LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane7.riseA", timeA7.length);
-    timeA7LenFallAtt = std::make_unique<SliderAtt>(processor.apvts, "lane7.curve.fallA", timeA7.length);
-    timeA7CurveRiseAtt = std::make_unique<SliderAtt>(processor.apvts, "lane7.curv.riseA", timeA7.curve);
-
-    // Time B: outer length mirrors riseB & fallB; inner curve drives curv.riseB
-    timeB7LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane7.riseB", timeB7.length);
-    timeB7LenFallAtt = std::make_unique<SliderAtt>(processor.apvts, "lane7.curve.fallB", timeB7.length);
-    timeB7CurveRiseAtt = std::make_unique<SliderAtt>(processor.apvts, "lane7.curv.fallA", timeB7.curve);
-
-    // Intensities: outer = amplitude; inner curve drives the FALL edges
-    intensityA7LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane7.intensityA", intensityA7.length);
-    intensityA7CurveAtt = std::make_unique<SliderAtt>(processor.apvts, "lane7.curv.riseB", intensityA7.curve);
-    intensityB7LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane7.intensityB", intensityB7.length);
-    intensityB7CurveAtt = std::make_unique<SliderAtt>(processor.apvts, "lane7.curv.fallB", intensityB7.curve);
-
-    // --- LANE 8 controls ----------------------------------------------------
-    addAndMakeVisible(phaseK8);
-    configSlider(phaseK8.slider, 0.0, 360.0, "°");
-
-    addAndMakeVisible(invertA8);
-    configSlider(invertA8.slider, -1.0, 1.0, "");
-    addAndMakeVisible(invertB8);
-    configSlider(invertB8.slider, -1.0, 1.0, "");
-
-    addAndMakeVisible(timeA8);
-    configSlider(timeA8.length, 0.25, 4.0, "");
-    configSlider(timeA8.curve, -1.0, 1.0, "");
-
-    addAndMakeVisible(timeB8);
-    configSlider(timeB8.length, 0.25, 4.0, "");
-    configSlider(timeB8.curve, -1.0, 1.0, "");
-
-    addAndMakeVisible(intensityA8);
-    configSlider(intensityA8.length, 0.0, 1.0, "");
-    configSlider(intensityA8.curve, -1.0, 1.0, "");
-
-    addAndMakeVisible(intensityB8);
-    configSlider(intensityB8.length, 0.0, 1.0, "");
-    configSlider(intensityB8.curve, -1.0, 1.0, "");
-
-    addAndMakeVisible(lane8Scope3);
-    lane8Scope3.setABTripletMode(true); // ABB triplet preview
-
-    // Double-click resets
-    for (auto *s : {&invertA8.slider, &invertB8.slider})
-        s->setDoubleClickReturnValue(true, 0.0);
-    for (auto *s : {&timeA8.curve, &timeB8.curve, &intensityA8.curve, &intensityB8.curve})
-        s->setDoubleClickReturnValue(true, 0.0);
-    phaseK8.slider.setDoubleClickReturnValue(true, 0.0);
-
-    // --- Attach to APVTS (lane 8) -------------------------------------------
-    phase8Att = std::make_unique<SliderAtt>(processor.apvts, "lane8.phaseDeg", phaseK8.slider);
-    invertA8Att = std::make_unique<SliderAtt>(processor.apvts, "lane8.invertA", invertA8.slider);
-    invertB8Att = std::make_unique<SliderAtt>(processor.apvts, "lane8.invertB", invertB8.slider);
-
-    // Time A
-    timeA8LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane8.riseA", timeA8.length);
-    timeA8LenFallAtt = std::make_unique<SliderAtt>(processor.apvts, "lane8.curve.fallA", timeA8.length);
-    timeA8CurveRiseAtt = std::make_unique<SliderAtt>(processor.apvts, "lane8.curv.riseA", timeA8.curve);
-
-    // Time B
-    timeB8LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane8.riseB", timeB8.length);
-    timeB8LenFallAtt = std::make_unique<SliderAtt>(processor.apvts, "lane8.curve.fallB", timeB8.length);
-    timeB8CurveRiseAtt = std::make_unique<SliderAtt>(processor.apvts, "lane8.curv.fallA", timeB8.curve);
-
-    // Intensities
-    intensityA8LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane8.intensityA", intensityA8.length);
-    intensityA8CurveAtt = std::make_unique<SliderAtt>(processor.apvts, "lane8.curv.riseB", intensityA8.curve);
-    intensityB8LenAtt = std::make_unique<SliderAtt>(processor.apvts, "lane8.intensityB", intensityB8.length);
-    intensityB8CurveAtt = std::make_unique<SliderAtt>(processor.apvts, "lane8.curv.fallB", intensityB8.curve);
-
     // --- Scopes -------------------------------------------------------------
-    addAndMakeVisible(lane1Scope2);
-    addAndMakeVisible(lane2Scope3);
-    addAndMakeVisible(lane3Scope2);
-    addAndMakeVisible(lane4Scope3);
-    addAndMakeVisible(lane5Scope2);
-    addAndMakeVisible(lane6Scope3);
-    addAndMakeVisible(lane7Scope2);
-    addAndMakeVisible(lane8Scope3);
-
-    // **Drive scopes from processor (DSP truth) so curvature/invert apply**
-    // ---- Lane scopes should ignore global phase nudge visually ---------------
-    auto wrap01 = [](float x)
-    { return x - std::floor(x); };
-
-    lane1Scope2.setEvaluator([this, wrap01](float ph01)
-                             {
-    const float nudge = processor.apvts.getRawParameterValue("global.phaseNudgeDeg")->load() / 360.0f;
-    return processor.evalLane1(wrap01(ph01 - nudge)); });
-
-    lane2Scope3.setEvaluator([this, wrap01](float ph01)
-                             {
-    const float nudge = processor.apvts.getRawParameterValue("global.phaseNudgeDeg")->load() / 360.0f;
-    return processor.evalLane2Triplet(wrap01(ph01 - nudge)); });
-
-    lane3Scope2.setEvaluator([this, wrap01](float ph01)
-                             {
-    const float nudge = processor.apvts.getRawParameterValue("global.phaseNudgeDeg")->load() / 360.0f;
-    return processor.evalLane3(wrap01(ph01 - nudge)); });
-
-    lane4Scope3.setEvaluator([this, wrap01](float ph01)
-                             {
-    const float nudge = processor.apvts.getRawParameterValue("global.phaseNudgeDeg")->load() / 360.0f;
-    return processor.evalLane4Triplet(wrap01(ph01 - nudge)); });
-
-    lane5Scope2.setEvaluator([this, wrap01](float ph01)
-                             {
-    const float nudge = processor.apvts.getRawParameterValue("global.phaseNudgeDeg")->load() / 360.0f;
-    return processor.evalLane5(wrap01(ph01 - nudge)); });
-
-    lane6Scope3.setEvaluator([this, wrap01](float ph01)
-                             {
-    const float nudge = processor.apvts.getRawParameterValue("global.phaseNudgeDeg")->load() / 360.0f;
-    return processor.evalLane6Triplet(wrap01(ph01 - nudge)); });
-
-    // If you added lanes 7/8:
-    lane7Scope2.setEvaluator([this, wrap01](float ph01)
-                             {
-    const float nudge = processor.apvts.getRawParameterValue("global.phaseNudgeDeg")->load() / 360.0f;
-    return processor.evalLane7(wrap01(ph01 - nudge)); });
-
-    lane8Scope3.setEvaluator([this, wrap01](float ph01)
-                             {
-    const float nudge = processor.apvts.getRawParameterValue("global.phaseNudgeDeg")->load() / 360.0f;
-    return processor.evalLane8Triplet(wrap01(ph01 - nudge)); });
-
-    // Update scopes when any relevant knob changes
-    auto upd1 = [this]
-    { updateLane1Scope(); updateOutputMixScope(); };
-    auto upd2 = [this]
-    { updateLane2Scope();  updateOutputMixScope(); };
-    auto upd3 = [this]
-    { updateLane3Scope(); updateOutputMixScope(); };
-    auto upd4 = [this]
-    { updateLane4Scope();  updateOutputMixScope(); };
-    auto upd5 = [this]
-    { updateLane5Scope(); updateOutputMixScope(); };
-    auto upd6 = [this]
-    { updateLane6Scope(); updateOutputMixScope(); };
-    auto upd7 = [this]
-    { updateLane7Scope(); updateOutputMixScope(); };
-    auto upd8 = [this]
-    { updateLane8Scope(); updateOutputMixScope(); };
-
-    // Lane 1 chain
-    chainOnValue(timeA1.length, upd1);
-    chainOnValue(timeA1.curve, upd1);
-    chainOnValue(timeB1.length, upd1);
-    chainOnValue(timeB1.curve, upd1);
-    chainOnValue(intensityA1.length, upd1);
-    chainOnValue(intensityA1.curve, upd1);
-    chainOnValue(intensityB1.length, upd1);
-    chainOnValue(intensityB1.curve, upd1);
-    chainOnValue(invertA1.slider, upd1);
-    chainOnValue(invertB1.slider, upd1);
-    chainOnValue(phaseK1.slider, upd1);
-
-    // Lane 2 chain
-    chainOnValue(timeA2.length, upd2);
-    chainOnValue(timeA2.curve, upd2);
-    chainOnValue(timeB2.length, upd2);
-    chainOnValue(timeB2.curve, upd2);
-    chainOnValue(intensityA2.length, upd2);
-    chainOnValue(intensityA2.curve, upd2);
-    chainOnValue(intensityB2.length, upd2);
-    chainOnValue(intensityB2.curve, upd2);
-    chainOnValue(invertA2.slider, upd2);
-    chainOnValue(invertB2.slider, upd2);
-    chainOnValue(phaseK2.slider, upd2);
-
-    // Lane 3 chain
-    chainOnValue(timeA3.length, upd3);
-    chainOnValue(timeA3.curve, upd3);
-    chainOnValue(timeB3.length, upd3);
-    chainOnValue(timeB3.curve, upd3);
-    chainOnValue(intensityA3.length, upd3);
-    chainOnValue(intensityA3.curve, upd3);
-    chainOnValue(intensityB3.length, upd3);
-    chainOnValue(intensityB3.curve, upd3);
-    chainOnValue(invertA3.slider, upd3);
-    chainOnValue(invertB3.slider, upd3);
-    chainOnValue(phaseK3.slider, upd3);
-
-    // Lane 4 chain
-    chainOnValue(timeA4.length, upd4);
-    chainOnValue(timeA4.curve, upd4);
-    chainOnValue(timeB4.length, upd4);
-    chainOnValue(timeB4.curve, upd4);
-    chainOnValue(intensityA4.length, upd4);
-    chainOnValue(intensityA4.curve, upd4);
-    chainOnValue(intensityB4.length, upd4);
-    chainOnValue(intensityB4.curve, upd4);
-    chainOnValue(invertA4.slider, upd4);
-    chainOnValue(invertB4.slider, upd4);
-    chainOnValue(phaseK4.slider, upd4);
-
-    // Lane 5 chain
-    chainOnValue(timeA5.length, upd5);
-    chainOnValue(timeA5.curve, upd5);
-    chainOnValue(timeB5.length, upd5);
-    chainOnValue(timeB5.curve, upd5);
-    chainOnValue(intensityA5.length, upd5);
-    chainOnValue(intensityA5.curve, upd5);
-    chainOnValue(intensityB5.length, upd5);
-    chainOnValue(intensityB5.curve, upd5);
-    chainOnValue(invertA5.slider, upd5);
-    chainOnValue(invertB5.slider, upd5);
-    chainOnValue(phaseK5.slider, upd5);
-
-    // Lane 6 chain
-    chainOnValue(timeA6.length, upd6);
-    chainOnValue(timeA6.curve, upd6);
-    chainOnValue(timeB6.length, upd6);
-    chainOnValue(timeB6.curve, upd6);
-    chainOnValue(intensityA6.length, upd6);
-    chainOnValue(intensityA6.curve, upd6);
-    chainOnValue(intensityB6.length, upd6);
-    chainOnValue(intensityB6.curve, upd6);
-    chainOnValue(invertA6.slider, upd6);
-    chainOnValue(invertB6.slider, upd6);
-    chainOnValue(phaseK6.slider, upd6);
-
-    // Lane 7 chain
-    chainOnValue(timeA7.length, upd7);
-    chainOnValue(timeA7.curve, upd7);
-    chainOnValue(timeB7.length, upd7);
-    chainOnValue(timeB7.curve, upd7);
-    chainOnValue(intensityA7.length, upd7);
-    chainOnValue(intensityA7.curve, upd7);
-    chainOnValue(intensityB7.length, upd7);
-    chainOnValue(intensityB7.curve, upd7);
-    chainOnValue(invertA7.slider, upd7);
-    chainOnValue(invertB7.slider, upd7);
-    chainOnValue(phaseK7.slider, upd7);
-
-    // Lane 8 chain
-    chainOnValue(timeA8.length, upd8);
-    chainOnValue(timeA8.curve, upd8);
-    chainOnValue(timeB8.length, upd8);
-    chainOnValue(timeB8.curve, upd8);
-    chainOnValue(intensityA8.length, upd8);
-    chainOnValue(intensityA8.curve, upd8);
-    chainOnValue(intensityB8.length, upd8);
-    chainOnValue(intensityB8.curve, upd8);
-    chainOnValue(invertA8.slider, upd8);
-    chainOnValue(invertB8.slider, upd8);
-    chainOnValue(phaseK8.slider, upd8);
+    // Point arrays are evaluated on the scope worker, never in paint()
+    scopeWorker.startThread(juce::Thread::Priority::low);
+    outputMixScope.setWorker(&scopeWorker);
+    outputMixScope.setScheduler(&scopeScheduler);
+
+    // Output card: mixed signal + the output slope/curve as a soft green overlay
+    addAndMakeVisible(outputMixScope);
+    outputMixScope.setEvaluator([this](const float *phases01, float *out, int n)
+                                { processor.evalMixed(phases01, out, n); });
+    outputMixScope.setOverlayEvaluator(
+        [this](const float *phases01, float *out, int n)
+        { processor.evalSlopeOnly(phases01, out, n); },
+        juce::Colour::fromFloatRGBA(0.55f, 0.95f, 0.75f, 0.70f) // soft green, semi-transparent
+    );
+
+    // Lane tabs end with the whole-pattern overview (built lazily, like the panels' scopes)
+    // and the live history of what processBlock actually renders
+    addChildComponent(overview);
+    addChildComponent(liveScope);
+    overview.setSource([this](const float *phases, float *out, int n)
+                       { processor.evalMixed(phases, out, n); },
+                       [this]
+                       { return processor.getPatternLengthCycles(); });
 
     // depth / phase nudge / slope affect the mixed scope
     chainOnValue(depthK.slider, [this]
@@ -761,7 +620,7 @@ PinkELFOntsAudioProcessorEditor::PinkELFOntsAudioProcessorEditor(PinkELFOntsAudi
                  { updateOutputMixScope(); });
 
     // mixer faders + on/off toggles affect the mixed scope
-    for (int i = 0; i < 8; ++i)
+    for (int i = 0; i < kMaxLaneTabs; ++i)
     {
         mixerFader[i].onValueChange = [this]
         { updateOutputMixScope(); };
@@ -769,47 +628,107 @@ PinkELFOntsAudioProcessorEditor::PinkELFOntsAudioProcessorEditor(PinkELFOntsAudi
         { updateOutputMixScope(); };
     }
 
-    laneTabs.setCurrentTabIndex(0, juce::NotificationType::dontSendNotification);
-    updateLane1Scope();
-    updateLane2Scope();
-    updateLane3Scope();
-    updateLane4Scope();
-    updateLane5Scope();
-    updateLane6Scope();
-    updateLane7Scope();
-    updateLane8Scope();
-    resized();
+    // ... and so does every lane parameter, including those of panels not built
+    // yet, and the lane count
+    for (auto *param : processor.getParameters())
+        if (auto *withId = dynamic_cast<juce::AudioProcessorParameterWithID *>(param))
+            if (withId->paramID.startsWith("lane") || withId->paramID == "global.numLanes")
+                laneParamIds.add(withId->paramID);
+    for (const auto &id : laneParamIds)
+        processor.apvts.addParameterListener(id, &laneParamListener);
+
+    // Debug overlay (hidden until Cmd/Ctrl+Shift+P)
+    addChildComponent(profilerOverlay);
+    setWantsKeyboardFocus(true);
+
+    updateLaneTabs(); // adds the tabs on lane 1, lays out and builds its panel
+
+    startTimer(kPanelIdleCheckMs);
 }
 
 PinkELFOntsAudioProcessorEditor::~PinkELFOntsAudioProcessorEditor()
 {
+    stopTimer();
+    for (const auto &id : laneParamIds)
+        processor.apvts.removeParameterListener(id, &laneParamListener);
     laneTabs.getTabbedButtonBar().removeChangeListener(this);
+    processor.presets.removeChangeListener(this);
     setLookAndFeel(nullptr);
 }
 
 void PinkELFOntsAudioProcessorEditor::paint(juce::Graphics &g)
 {
+    if (UiProfiler::get().isEnabled())
+        frameStartTicks = juce::Time::getHighResolutionTicks();
+
     g.fillAll(juce::Colour(0xFF0B0D10));
 }
 
+void PinkELFOntsAudioProcessorEditor::paintOverChildren(juce::Graphics &)
+{
+    // Children paint between paint() and here: that's the editor's frame cost
+    if (frameStartTicks != 0)
+    {
+        UiProfiler::get().recordFrame(juce::Time::highResolutionTicksToSeconds(
+                                          juce::Time::getHighResolutionTicks() - frameStartTicks) * 1000.0);
+        frameStartTicks = 0;
+    }
+}
+
+bool PinkELFOntsAudioProcessorEditor::keyPressed(const juce::KeyPress &key)
+{
+    const auto mods = juce::ModifierKeys::commandModifier | juce::ModifierKeys::shiftModifier;
+
+    if (key == juce::KeyPress('p', mods, 0))
+    {
+        profilerOverlay.toggle();
+        return true;
+    }
+
+    if (key == juce::KeyPress('d', mods, 0))
+    {
+        const auto file = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+                              .getNonexistentChildFile("pink eLFOnts UI profile", ".txt");
+        UiProfiler::get().dumpToFile(file);
+        return true;
+    }
+
+    return false;
+}
+
 void PinkELFOntsAudioProcessorEditor::resized()
 {
-    auto bounds = getLocalBounds().reduced(kPad);
+    PLF_PROFILE_UI("Editor::resized");
+    PLF_TRACE_SCOPE("Editor::resized");
+
+    uiScale = juce::jlimit(kMinScale, kMaxScale, (float)getWidth() / (float)kBaseW);
+    const Layout L(uiScale);
+
+    auto bounds = getLocalBounds().reduced(L.pad);
 
     // Top bar
-    auto top = bounds.removeFromTop(kRowH);
-    title.setBounds(top.removeFromLeft(280));
-    top.removeFromRight(kGap);
+    auto top = bounds.removeFromTop(L.rowH);
+    title.setFont(juce::Font(juce::FontOptions(18.0f * uiScale, juce::Font::bold)));
+    title.setBounds(top.removeFromLeft(L.px(150)));
+    top.removeFromRight(L.gap);
 
-    // Right side of top bar: rateBox then retrigBox
-    const int comboW = 240, comboH = 34, gapX = 16;
+    // Right side of top bar: rateBox, retrigBox, then the lane count
+    const int comboW = L.px(200), comboH = L.px(34), gapX = L.px(16);
     rateBox.setBounds(top.removeFromRight(comboW).reduced(0, (top.getHeight() - comboH) / 2));
     top.removeFromRight(gapX);
     retrigBox.setBounds(top.removeFromRight(comboW).reduced(0, (top.getHeight() - comboH) / 2));
+    top.removeFromRight(gapX);
+    lanesBox.setBounds(top.removeFromRight(L.px(110)).reduced(0, (top.getHeight() - comboH) / 2));
+    top.removeFromRight(gapX);
+
+    // Whatever is left: preset browser + save
+    savePresetBtn.setBounds(top.removeFromRight(L.px(56)).reduced(0, (top.getHeight() - comboH) / 2));
+    top.removeFromRight(L.px(6));
+    presetBox.setBounds(top.reduced(0, (top.getHeight() - comboH) / 2));
 
     // --- Cards --------------------------------------------------------------
     // Right: Mixer card (remainder of the top row)
-    auto row1 = bounds.removeFromTop(kCardH);
+    auto row1 = bounds.removeFromTop(L.cardH);
     auto outputArea = row1.removeFromLeft(int(row1.getWidth() * 0.58f));
     secOutput.setBounds(outputArea);
 
@@ -817,17 +736,18 @@ void PinkELFOntsAudioProcessorEditor::resized()
     secMixer.setBounds(mixerArea);
 
     // Layout: labels, faders, mute dots
-    auto m = mixerArea.reduced(16, 32);
-    m.removeFromTop(4); // breathing room under section header
+    auto m = mixerArea.reduced(L.px(16), L.px(32));
+    m.removeFromTop(L.px(4)); // breathing room under section header
     // Row for labels
-    auto labelsRow = m.removeFromTop(24);
-    m.removeFromTop(8);
+    auto labelsRow = m.removeFromTop(L.px(24));
+    m.removeFromTop(L.px(8));
 
-    // Compute columns
-    const int cols = 8;
-    const int colW = (m.getWidth() - gapX * (cols - 1)) / cols;
-    const int muteH = 22;
-    const int faderH = juce::jmin(160, m.getHeight() - muteH - 12);
+    // Compute columns (narrower gaps once there are more than eight)
+    const int cols = numShownLanes;
+    const int colGap = cols > 8 ? L.px(4) : gapX;
+    const int colW = (m.getWidth() - colGap * (cols - 1)) / juce::jmax(1, cols);
+    const int muteH = L.px(22);
+    const int faderH = juce::jmin(L.px(160), m.getHeight() - muteH - L.px(12));
 
     auto cursorLabels = labelsRow;
     auto cursorCols = m;
@@ -840,49 +760,52 @@ void PinkELFOntsAudioProcessorEditor::resized()
         auto col = cursorCols.removeFromLeft(colW);
         if (i < cols - 1)
         {
-            cursorLabels.removeFromLeft(gapX);
-            cursorCols.removeFromLeft(gapX);
+            cursorLabels.removeFromLeft(colGap);
+            cursorCols.removeFromLeft(colGap);
         }
 
         // Fader centered in column, above mute row
-        auto faderRect = col.withTrimmedBottom(muteH + 8)
+        auto faderRect = col.withTrimmedBottom(muteH + L.px(8))
                              .withSizeKeepingCentre(colW, faderH)
-                             .reduced(10, 4);
+                             .reduced(juce::jmin(L.px(10), colW / 4), L.px(4));
         mixerFader[i].setBounds(faderRect);
+        mixerMeter[i].setBounds(faderRect.getRight() + L.px(2), faderRect.getY(), L.px(4), faderRect.getHeight());
 
         // Mute dot at base
         auto muteArea = col.removeFromBottom(muteH);
-        mixerOn[i].setBounds(muteArea.withSizeKeepingCentre(18, 18));
+        mixerOn[i].setBounds(muteArea.withSizeKeepingCentre(L.px(18), L.px(18)));
     }
 
-    auto laneCardArea = bounds.removeFromTop(kLaneH);
+    auto laneCardArea = bounds.removeFromTop(L.laneH);
     secLane.setBounds(laneCardArea);
 
-    laneTabs.setBounds(laneCardArea.reduced(12, 12));
+    laneTabs.setTabBarDepth(L.px(30));
+    laneTabs.setBounds(laneCardArea.reduced(L.px(12), L.px(12)));
     const int tabH = laneTabs.getTabbedButtonBar().getHeight();
 
     // ===== Output section layout (nudge top row down; keep scope aspect) =====
     {
-        auto r = outputArea.reduced(16, 18); // inner padding
+        auto r = outputArea.reduced(L.px(16), L.px(18)); // inner padding
 
-        constexpr int knobW = kKnob, knobH = kKnob;
-        constexpr int dual = kDual;
-        constexpr int gap = kGap;
+        const int knobW = L.knob, knobH = L.knob;
+        depthK.uiScale = phaseNudgeK.uiScale = slopeK.uiScale = uiScale;
+        const int dual = L.dual;
+        const int gap = L.gap;
         constexpr float kScopeAspect = 2.40f; // fixed aspect for scope
 
         // Left column sized to comfortably hold the big dual knob
-        const int leftColW = std::max(2 * knobW + gap, dual) + 16;
+        const int leftColW = std::max(2 * knobW + gap, dual) + L.px(16);
         auto leftCol = r.removeFromLeft(leftColW);
 
         // --- Place Slope / Curve first, anchored to the bottom of the column ---
-        const int bottomPad = 6; // breathing room to card bottom
+        const int bottomPad = L.px(6); // breathing room to card bottom
         const int slopeY = leftCol.getBottom() - dual - bottomPad;
         auto slopeRow = juce::Rectangle<int>(leftCol.getX(), slopeY, leftCol.getWidth(), dual);
         slopeK.setBounds(slopeRow.withSizeKeepingCentre(dual, dual));
 
         // --- Top row (Depth | Phase Nudge) just above the dual knob ------------
-        const int minTopMargin = 12; // keep headers inside the card
-        const int between = 10;      // distance between rows
+        const int minTopMargin = L.px(12); // keep headers inside the card
+        const int between = L.px(10);      // distance between rows
 
         int topY = slopeRow.getY() - between - knobH;         // sit just above slope row
         topY = std::max(topY, leftCol.getY() + minTopMargin); // never too high
@@ -906,333 +829,171 @@ void PinkELFOntsAudioProcessorEditor::resized()
     }
 
     // --- Tab content --------------------------------------------------------
-    const int tab = laneTabs.getCurrentTabIndex();
-    auto content = laneTabs.getBounds().reduced(16, 16).withTrimmedTop(tabH + 6);
-
-    const bool lane1Visible = (tab == 0);
-    const bool lane2Visible = (tab == 1);
-    const bool lane3Visible = (tab == 2);
-    const bool lane4Visible = (tab == 3);
-    const bool lane5Visible = (tab == 4);
-    const bool lane6Visible = (tab == 5);
-    const bool lane7Visible = (tab == 6);
-    const bool lane8Visible = (tab == 7);
-
-    // LANE 1 controls visibility
-    phaseK1.setVisible(lane1Visible);
-    invertA1.setVisible(lane1Visible);
-    invertB1.setVisible(lane1Visible);
-    timeA1.setVisible(lane1Visible);
-    timeB1.setVisible(lane1Visible);
-    intensityA1.setVisible(lane1Visible);
-    intensityB1.setVisible(lane1Visible);
-    lane1Scope2.setVisible(lane1Visible);
-
-    // LANE 2 controls visibility
-    phaseK2.setVisible(lane2Visible);
-    invertA2.setVisible(lane2Visible);
-    invertB2.setVisible(lane2Visible);
-    timeA2.setVisible(lane2Visible);
-    timeB2.setVisible(lane2Visible);
-    intensityA2.setVisible(lane2Visible);
-    intensityB2.setVisible(lane2Visible);
-    lane2Scope3.setVisible(lane2Visible);
-
-    // LANE 3 controls visibility
-    phaseK3.setVisible(lane3Visible);
-    invertA3.setVisible(lane3Visible);
-    invertB3.setVisible(lane3Visible);
-    timeA3.setVisible(lane3Visible);
-    timeB3.setVisible(lane3Visible);
-    intensityA3.setVisible(lane3Visible);
-    intensityB3.setVisible(lane3Visible);
-    lane3Scope2.setVisible(lane3Visible);
-
-    // LANE 4 controls visibility
-    phaseK4.setVisible(lane4Visible);
-    invertA4.setVisible(lane4Visible);
-    invertB4.setVisible(lane4Visible);
-    timeA4.setVisible(lane4Visible);
-    timeB4.setVisible(lane4Visible);
-    intensityA4.setVisible(lane4Visible);
-    intensityB4.setVisible(lane4Visible);
-    lane4Scope3.setVisible(lane4Visible);
-
-    // LANE 5 controls visibility
-    phaseK5.setVisible(lane5Visible);
-    invertA5.setVisible(lane5Visible);
-    invertB5.setVisible(lane5Visible);
-    timeA5.setVisible(lane5Visible);
-    timeB5.setVisible(lane5Visible);
-    intensityA5.setVisible(lane5Visible);
-    intensityB5.setVisible(lane5Visible);
-    lane5Scope2.setVisible(lane5Visible);
-
-    // LANE 6 controls visibility
-    phaseK6.setVisible(lane6Visible);
-    invertA6.setVisible(lane6Visible);
-    invertB6.setVisible(lane6Visible);
-    timeA6.setVisible(lane6Visible);
-    timeB6.setVisible(lane6Visible);
-    intensityA6.setVisible(lane6Visible);
-    intensityB6.setVisible(lane6Visible);
-    lane6Scope3.setVisible(lane6Visible);
-
-    // LANE 7
-    phaseK7.setVisible(lane7Visible);
-    invertA7.setVisible(lane7Visible);
-    invertB7.setVisible(lane7Visible);
-    timeA7.setVisible(lane7Visible);
-    timeB7.setVisible(lane7Visible);
-    intensityA7.setVisible(lane7Visible);
-    intensityB7.setVisible(lane7Visible);
-    lane7Scope2.setVisible(lane7Visible);
-
-    // LANE 8
-    phaseK8.setVisible(lane8Visible);
-    invertA8.setVisible(lane8Visible);
-    invertB8.setVisible(lane8Visible);
-    timeA8.setVisible(lane8Visible);
-    timeB8.setVisible(lane8Visible);
-    intensityA8.setVisible(lane8Visible);
-    intensityB8.setVisible(lane8Visible);
-    lane8Scope3.setVisible(lane8Visible);
-
-    auto layoutLane = [&]()
-    {
-        auto r = content;
-
-        // Left controls / Right scope
-        const int cols = 4;
-        const int colW = kDual;
-        const int colGap = kGap;
-        const int gridW = cols * colW + (cols - 1) * colGap;
-
-        const int controlsW = gridW + 4;
-        auto controls = r.removeFromLeft(controlsW);
-        auto scope = r.reduced(8, 6);
-
-        // Pick the scope for the visible lane
-        juce::Component *scopeView = nullptr;
-        if (lane1Visible)
-            scopeView = &lane1Scope2;
-        else if (lane2Visible)
-            scopeView = &lane2Scope3;
-        else if (lane3Visible)
-            scopeView = &lane3Scope2;
-        else if (lane4Visible)
-            scopeView = &lane4Scope3;
-        else if (lane5Visible)
-            scopeView = &lane5Scope2;
-        else if (lane6Visible)
-            scopeView = &lane6Scope3;
-        else if (lane7Visible)
-            scopeView = &lane7Scope2;
-        else if (lane8Visible)
-            scopeView = &lane8Scope3;
-
-        if (scopeView != nullptr)
-            scopeView->setBounds(scope);
-
-        // (If you show the global/output scope here, keep this; otherwise remove)
-        addAndMakeVisible(outputMixScope);
-        outputMixScope.setEvaluator([this](float ph01)
-                                    { return processor.evalMixed(ph01); });
-
-        // draw the output slope/curve as a soft green overlay
-        outputMixScope.setOverlayEvaluator(
-            [this](float ph01)
-            { return processor.evalSlopeOnly(ph01); },
-            juce::Colour::fromFloatRGBA(0.55f, 0.95f, 0.75f, 0.70f) // soft green, semi-transparent
-        );
-
-        // ---------------- Row 0: Phase | Invert A | Invert B (centered) ----------
-        auto row0 = controls.removeFromTop(kKnob);
-        auto placeTop = [&](Knob &k)
-        {
-            k.setBounds(row0.removeFromLeft(colW));
-            row0.removeFromLeft(colGap);
-        };
-
-        // Leave one slot empty to center 3 knobs in a 4-slot row
-        row0.removeFromLeft(colW + colGap);
+    laneContentArea = laneTabs.getBounds().reduced(L.px(16), L.px(16)).withTrimmedTop(tabH + L.px(6));
+    showLaneTab(laneTabs.getCurrentTabIndex());
 
-        if (lane1Visible)
-        {
-            placeTop(phaseK1);
-            placeTop(invertA1);
-            placeTop(invertB1);
-        }
-        else if (lane2Visible)
-        {
-            placeTop(phaseK2);
-            placeTop(invertA2);
-            placeTop(invertB2);
-        }
-        else if (lane3Visible)
-        {
-            placeTop(phaseK3);
-            placeTop(invertA3);
-            placeTop(invertB3);
-        }
-        else if (lane4Visible)
-        {
-            placeTop(phaseK4);
-            placeTop(invertA4);
-            placeTop(invertB4);
-        }
-        else if (lane5Visible)
-        {
-            placeTop(phaseK5);
-            placeTop(invertA5);
-            placeTop(invertB5);
-        }
-        else if (lane6Visible)
-        {
-            placeTop(phaseK6);
-            placeTop(invertA6);
-            placeTop(invertB6);
-        }
-        else if (lane7Visible)
-        {
-            placeTop(phaseK7);
-            placeTop(invertA7);
-            placeTop(invertB7);
-        }
-        else if (lane8Visible)
-        {
-            placeTop(phaseK8);
-            placeTop(invertA8);
-            placeTop(invertB8);
-        }
+    profilerOverlay.setBounds(getLocalBounds().reduced(L.pad).removeFromRight(560).removeFromBottom(300));
+    profilerOverlay.toFront(false);
+}
 
-        controls.removeFromTop(kGap);
+void PinkELFOntsAudioProcessorEditor::showLaneTab(int tab)
+{
+    const auto now = juce::Time::getMillisecondCounter();
 
-        // ------ Row 1: Time A | Time B | Intensity A | Intensity B ----------
-        auto rowDual = controls.removeFromTop(kDual);
-        auto placeDual = [&](DualKnob &dk)
-        {
-            dk.setBounds(rowDual.removeFromLeft(colW));
-            rowDual.removeFromLeft(colGap);
-        };
+    for (int i = 0; i < (int)lanePanels.size(); ++i)
+    {
+        auto &panel = lanePanels[(size_t)i];
 
-        if (lane1Visible)
-        {
-            placeDual(timeA1);
-            placeDual(timeB1);
-            placeDual(intensityA1);
-            placeDual(intensityB1);
-        }
-        else if (lane2Visible)
-        {
-            placeDual(timeA2);
-            placeDual(timeB2);
-            placeDual(intensityA2);
-            placeDual(intensityB2);
-        }
-        else if (lane3Visible)
-        {
-            placeDual(timeA3);
-            placeDual(timeB3);
-            placeDual(intensityA3);
-            placeDual(intensityB3);
-        }
-        else if (lane4Visible)
-        {
-            placeDual(timeA4);
-            placeDual(timeB4);
-            placeDual(intensityA4);
-            placeDual(intensityB4);
-        }
-        else if (lane5Visible)
+        if (i == tab)
         {
-            placeDual(timeA5);
-            placeDual(timeB5);
-            placeDual(intensityA5);
-            placeDual(intensityB5);
+            if (panel == nullptr)
+            {
+                panel = std::make_unique<LanePanel>(processor, i + 1, scopeWorker, scopeScheduler,
+                                                    [this]
+                                                    { updateOutputMixScope(); });
+                addChildComponent(*panel);
+            }
+            panel->setUiScale(uiScale);
+            panel->setBounds(laneContentArea);
+            panel->setVisible(true);
         }
-        else if (lane6Visible)
+        else if (panel != nullptr && panel->isVisible())
         {
-            placeDual(timeA6);
-            placeDual(timeB6);
-            placeDual(intensityA6);
-            placeDual(intensityB6);
+            panel->setVisible(false);
+            panel->hiddenSinceMs = now;
         }
-        else if (lane7Visible)
-        {
-            placeDual(timeA7);
-            placeDual(timeB7);
-            placeDual(intensityA7);
-            placeDual(intensityB7);
-        }
-        else if (lane8Visible)
-        {
-            placeDual(timeA8);
-            placeDual(timeB8);
-            placeDual(intensityA8);
-            placeDual(intensityB8);
-        }
-    };
+    }
 
-    if (lane1Visible || lane2Visible || lane3Visible || lane4Visible || lane5Visible || lane6Visible || lane7Visible || lane8Visible)
-        layoutLane();
+    const bool showOverview = (tab == numShownLanes);
+    auto overviewArea = laneContentArea;
+    overview.setBounds(overviewArea.removeFromTop(overviewArea.getHeight() * 3 / 5));
+    overviewArea.removeFromTop(juce::roundToInt(10.0f * uiScale));
+    liveScope.setBounds(overviewArea);
+    overview.setVisible(showOverview);
+    liveScope.setVisible(showOverview);
 }
 
-void PinkELFOntsAudioProcessorEditor::changeListenerCallback(juce::ChangeBroadcaster *source)
+void PinkELFOntsAudioProcessorEditor::updateLaneTabs()
 {
-    if (source == &laneTabs.getTabbedButtonBar())
+    const int shown = processor.getNumActiveLanes();
+
+    if (shown != numShownLanes)
+    {
+        // Keep the overview selected if it was; otherwise stay on the lane if it is still there
+        const int current = laneTabs.getCurrentTabIndex();
+        const bool onOverview = numShownLanes > 0 && current == numShownLanes;
+
+        laneTabs.clearTabs();
+        for (int i = 0; i < shown; ++i)
+            laneTabs.addTab({}, juce::Colours::transparentBlack, nullptr, false);
+        laneTabs.addTab("Overview", juce::Colours::transparentBlack, nullptr, false);
+        numShownLanes = shown;
+
+        // Panels and strips of lanes that are no longer active go
+        for (int i = 0; i < kMaxLaneTabs; ++i)
+        {
+            if (i >= shown)
+                lanePanels[(size_t)i].reset();
+            mixerLbl[(size_t)i].setVisible(i < shown);
+            mixerFader[(size_t)i].setVisible(i < shown);
+            mixerOn[(size_t)i].setVisible(i < shown);
+            mixerMeter[(size_t)i].setVisible(i < shown);
+        }
+
+        laneTabs.setCurrentTabIndex(onOverview ? shown : juce::jlimit(0, shown - 1, current),
+                                    juce::dontSendNotification);
         resized();
-}
+    }
 
-void PinkELFOntsAudioProcessorEditor::updateLane1Scope()
-{
-    // evaluator pulls from APVTS in processor; just repaint
-    lane1Scope2.repaint();
+    for (int i = 0; i < shown; ++i)
+    {
+        laneTabs.setTabName(i, "Lane " + juce::String(i + 1) + " (" + processor.getLaneDivisionName(i + 1) + ")");
+        if (auto &panel = lanePanels[(size_t)i])
+            panel->updateDivision();
+    }
 }
 
-void PinkELFOntsAudioProcessorEditor::updateLane2Scope()
+void PinkELFOntsAudioProcessorEditor::timerCallback()
 {
-    // evaluator pulls from APVTS in processor; just repaint
-    lane2Scope3.repaint();
+    // Tear down lane panels nobody has looked at for a while
+    const auto now = juce::Time::getMillisecondCounter();
+    for (auto &panel : lanePanels)
+        if (panel != nullptr && !panel->isVisible() && now - panel->hiddenSinceMs > kPanelIdleMs)
+            panel.reset();
 }
 
-void PinkELFOntsAudioProcessorEditor::updateLane3Scope()
+void PinkELFOntsAudioProcessorEditor::changeListenerCallback(juce::ChangeBroadcaster *source)
 {
-    // evaluator pulls from APVTS in processor; just repaint
-    lane3Scope2.repaint();
+    if (source == &laneTabs.getTabbedButtonBar())
+        resized();
+    else if (source == &processor.presets)
+        refreshPresetBox();
 }
 
-void PinkELFOntsAudioProcessorEditor::updateLane4Scope()
+void PinkELFOntsAudioProcessorEditor::refreshPresetBox()
 {
-    // evaluator pulls from APVTS in processor; just repaint
-    lane4Scope3.repaint();
-}
+    // Item IDs are library index + 1; one section heading per bank file
+    presetBox.clear(juce::dontSendNotification);
 
-void PinkELFOntsAudioProcessorEditor::updateLane5Scope()
-{
-    // evaluator pulls from APVTS in processor; just repaint
-    lane5Scope2.repaint();
-}
+    const auto bankNames = processor.presets.getBankNames();
+    const auto entries = processor.presets.getEntries();
 
-void PinkELFOntsAudioProcessorEditor::updateLane6Scope()
-{
-    // evaluator pulls from APVTS in processor; just repaint
-    lane6Scope3.repaint();
+    int lastBank = -1;
+    for (int i = 0; i < entries.size(); ++i)
+    {
+        const auto &e = entries.getReference(i);
+        if (e.bank != lastBank)
+        {
+            presetBox.addSectionHeading(bankNames[e.bank]);
+            lastBank = e.bank;
+        }
+        presetBox.addItem(e.tags.isEmpty() ? e.name : e.name + "  [" + e.tags + "]", i + 1);
+    }
+
+    const int current = processor.presets.getCurrentIndex();
+    if (current >= 0)
+        presetBox.setSelectedId(current + 1, juce::dontSendNotification);
 }
 
-void PinkELFOntsAudioProcessorEditor::updateLane7Scope()
+void PinkELFOntsAudioProcessorEditor::savePresetPrompt()
 {
-    // evaluator pulls from APVTS in processor; just repaint
-    lane7Scope2.repaint();
+    auto *w = new juce::AlertWindow("Save preset", "Stores the current settings in the User bank.",
+                                     juce::MessageBoxIconType::NoIcon, this);
+    w->addTextEditor("name", "New preset", "Name");
+    w->addTextEditor("tags", {}, "Tags");
+    w->addButton("Save", 1, juce::KeyPress(juce::KeyPress::returnKey));
+    w->addButton("Cancel", 0, juce::KeyPress(juce::KeyPress::escapeKey));
+
+    juce::Component::SafePointer<PinkELFOntsAudioProcessorEditor> safeThis(this);
+    w->enterModalState(true, juce::ModalCallbackFunction::create([safeThis, w](int result)
+                                                                 {
+        if (result != 1 || safeThis == nullptr)
+            return;
+
+        const auto name = w->getTextEditorContents("name").trim();
+        if (name.isEmpty())
+            return;
+
+        if (!safeThis->processor.presets.saveCurrent(name, w->getTextEditorContents("tags").trim()))
+            juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Save preset",
+                                                   "\"" + name + "\" could not be written to the User bank.",
+                                                   {}, safeThis.getComponent()); }),
+                       true);
 }
 
-void PinkELFOntsAudioProcessorEditor::updateLane8Scope()
+void PinkELFOntsAudioProcessorEditor::updateOutputMixScope()
 {
-    // evaluator pulls from APVTS in processor; just repaint
-    lane8Scope3.repaint();
+    scopeScheduler.markDirty(outputMixScope);
+    overview.invalidate(); // only flags it while another tab is shown
 }
 
-void PinkELFOntsAudioProcessorEditor::updateOutputMixScope()
+void PinkELFOntsAudioProcessorEditor::updateMeters()
 {
-    outputMixScope.repaint();
+    // Peaks are consumed (reset to 0) so each frame sees the max since the last one
+    for (size_t i = 0; i < mixerMeter.size(); ++i)
+    {
+        auto &source = processor.laneMeters[i];
+        mixerMeter[i].setLevels(source.rms.load(std::memory_order_relaxed),
+                                source.peak.exchange(0.0f, std::memory_order_relaxed));
+    }
 }
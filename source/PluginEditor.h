@@ -1,19 +1,33 @@
 #pragma once
 #include <JuceHeader.h>
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <vector>
+#include "HistoryScope.h"
 #include "LFOShape.h" // single source of truth for the lane shape (namespace LFO)
+#include "OverviewScope.h"
+#include "Trace.h"
+#include "UiProfiler.h"
 
 class PinkELFOntsAudioProcessor;
 
+// Lanes the editor has tabs / mixer strips for: PinkELFOntsAudioProcessor::numLanes
+// (checked in PluginEditor.cpp); global.numLanes picks how many are shown
+constexpr int kMaxLaneTabs = 16;
+
 // ---------- small UI helpers ----------
 
 struct Section : juce::Component
 {
     juce::String title;
-    explicit Section(juce::String t = {}) : title(std::move(t)) {}
+    // Static card: rendered once per size / scale and blitted afterwards
+    explicit Section(juce::String t = {}) : title(std::move(t)) { setBufferedToImage(true); }
 
     void paint(juce::Graphics &g) override
     {
+        PLF_PROFILE_UI("Section::paint");
+
         auto bg = juce::Colour(0xFF141821);
         auto stroke = juce::Colour(0xFF262B38);
 
@@ -39,6 +53,7 @@ struct Knob : juce::Component
 {
     juce::Label caption, value;
     juce::Slider slider; // rotary
+    float uiScale = 1.0f; // editor scale, set before layout
 
     explicit Knob(juce::String captionText = {})
     {
@@ -69,11 +84,17 @@ struct Knob : juce::Component
 
     void resized() override
     {
+        auto px = [this](float v)
+        { return juce::roundToInt(v * uiScale); };
+
+        caption.setFont(juce::Font(juce::FontOptions(15.0f * uiScale)));
+        value.setFont(juce::Font(juce::FontOptions(15.0f * uiScale)));
+
         auto r = getLocalBounds();
-        caption.setBounds(r.removeFromTop(16));
-        auto pill = r.removeFromBottom(18).reduced(10, 2);
+        caption.setBounds(r.removeFromTop(px(16)));
+        auto pill = r.removeFromBottom(px(18)).reduced(px(10), 2);
         value.setBounds(pill);
-        slider.setBounds(r.reduced(8));
+        slider.setBounds(r.reduced(px(8)));
     }
 };
 
@@ -83,6 +104,7 @@ struct DualKnob : juce::Component
     juce::Label caption;
     juce::Slider length; // outer
     juce::Slider curve;  // inner (0..1)
+    float uiScale = 1.0f; // editor scale, set before layout
 
     explicit DualKnob(juce::String text = {})
     {
@@ -108,10 +130,12 @@ struct DualKnob : juce::Component
 
     void resized() override
     {
+        caption.setFont(juce::Font(juce::FontOptions(15.0f * uiScale)));
+
         auto r = getLocalBounds();
-        caption.setBounds(r.removeFromTop(16));
+        caption.setBounds(r.removeFromTop(juce::roundToInt(16.0f * uiScale)));
 
-        auto area = r.reduced(6);
+        auto area = r.reduced(juce::roundToInt(6.0f * uiScale));
         length.setBounds(area);
 
         // inner knob ~54% of outer
@@ -164,18 +188,112 @@ struct SwitchMatrix : juce::Component
     }
 };
 
+// ---- Vertical contribution meter (RMS bar + decaying peak line) ----------
+// Values are 0..1 modulation levels; the editor feeds them once per vblank and
+// a meter only repaints when what it shows has actually moved.
+struct LevelMeter : juce::Component
+{
+    LevelMeter() { setInterceptsMouseClicks(false, false); }
+
+    void setLevels(float newRms, float blockPeak)
+    {
+        // peak hold that falls back over ~0.5 s at 60 Hz
+        const float newPeak = juce::jmax(blockPeak, peak * 0.92f);
+        const float newRmsClamped = juce::jlimit(0.0f, 1.0f, newRms);
+
+        if (std::abs(newPeak - peak) * (float)getHeight() < 0.5f &&
+            std::abs(newRmsClamped - rms) * (float)getHeight() < 0.5f)
+            return;
+
+        peak = newPeak;
+        rms = newRmsClamped;
+        repaint();
+    }
+
+    void paint(juce::Graphics &g) override
+    {
+        auto r = getLocalBounds().toFloat();
+        g.setColour(findColour(juce::Slider::backgroundColourId).darker(0.3f));
+        g.fillRoundedRectangle(r, 1.5f);
+
+        const auto fill = findColour(juce::Slider::thumbColourId);
+        g.setColour(fill.withAlpha(0.85f));
+        g.fillRect(r.withTop(r.getBottom() - r.getHeight() * rms));
+
+        if (peak > 0.001f)
+        {
+            g.setColour(fill.brighter(0.6f));
+            g.fillRect(r.withTop(r.getBottom() - r.getHeight() * juce::jmin(1.0f, peak)).withHeight(1.5f));
+        }
+    }
+
+    float rms = 0.0f, peak = 0.0f;
+};
+
+// ---- Background worker for scope point arrays ------------------------------
+// One thread per editor. Scopes flag themselves dirty and wake the worker,
+// which re-evaluates their point arrays off the message thread.
+struct ScopeTriangles;
+class ScopeRepaintScheduler;
+
+class ScopeWorker : public juce::Thread
+{
+public:
+    ScopeWorker() : juce::Thread("pink eLFOnts scopes") {}
+    ~ScopeWorker() override { stopThread(2000); }
+
+    // Scopes register on creation and unregister on destruction; remove()
+    // blocks until any computation for that scope has finished.
+    void add(ScopeTriangles *s)
+    {
+        const juce::ScopedLock sl(lock);
+        scopes.addIfNotAlreadyThere(s);
+    }
+    void remove(ScopeTriangles *s)
+    {
+        const juce::ScopedLock sl(lock);
+        scopes.removeFirstMatchingValue(s);
+    }
+
+    void run() override; // defined below ScopeTriangles
+
+private:
+    juce::CriticalSection lock;
+    juce::Array<ScopeTriangles *> scopes;
+};
+
 // ---- Scope that can render from either UI shape OR a processor evaluator ---
-struct ScopeTriangles : juce::Component
+// Points are cached and only recomputed (on the ScopeWorker, if one is set)
+// after invalidate() or a size change; paint() just strokes the cached paths.
+struct ScopeTriangles : juce::Component,
+                        private juce::AsyncUpdater
 {
     explicit ScopeTriangles(int triangles = 2) : numTriangles(triangles)
     {
         setInterceptsMouseClicks(false, false);
+        request.periods = 0.5f * (float)numTriangles;
     }
 
+    ~ScopeTriangles() override
+    {
+        if (worker != nullptr)
+            worker->remove(this);
+    }
+
+    void setWorker(ScopeWorker *w)
+    {
+        worker = w;
+        if (worker != nullptr)
+            worker->add(this);
+        invalidate();
+    }
+
+    int getNumTriangles() const { return numTriangles; }
+
     void setNumTriangles(int n)
     {
         numTriangles = juce::jlimit(1, 16, n);
-        repaint();
+        invalidate();
     }
     void setABTripletMode(bool on)
     {
@@ -185,45 +303,155 @@ struct ScopeTriangles : juce::Component
 
     void setFromShape(const LFO::Shape &s, float phaseDeg)
     {
-        shape = s;
-        phase01 = juce::jlimit(0.0f, 1.0f, phaseDeg / 360.0f);
-        repaint();
+        {
+            const juce::SpinLock::ScopedLockType sl(requestLock);
+            request.shape = s;
+            request.phase01 = juce::jlimit(0.0f, 1.0f, phaseDeg / 360.0f);
+        }
+        invalidate();
     }
 
-    void setEvaluator(std::function<float(float)> fn)
+    // Batch evaluator: fills out[0..n) from phases01[0..n) in one call.
+    using Evaluator = std::function<void(const float *phases01, float *out, int n)>;
+
+    void setEvaluator(Evaluator fn)
     {
-        evaluator = std::move(fn);
-        repaint();
+        hasEvaluator = (fn != nullptr);
+        {
+            const juce::SpinLock::ScopedLockType sl(requestLock);
+            request.evaluator = std::move(fn);
+        }
+        invalidate();
     }
 
     // --- optional overlay (e.g., output slope/curve) ------------------------
-    void setOverlayEvaluator(std::function<float(float)> fn, juce::Colour c)
+    void setOverlayEvaluator(Evaluator fn, juce::Colour c)
     {
-        overlayEval = std::move(fn);
         overlayColour = c;
-        repaint();
+        {
+            const juce::SpinLock::ScopedLockType sl(requestLock);
+            request.overlayEval = std::move(fn);
+        }
+        invalidate();
     }
 
+    // Parameters behind the evaluators changed: recompute the point arrays.
+    // A scope that isn't on screen only remembers it and recomputes once, the
+    // next time it is shown.
+    void invalidate()
+    {
+        if (!isShowing())
+        {
+            staleWhileHidden = true;
+            return;
+        }
+        staleWhileHidden = false;
+
+        {
+            const juce::SpinLock::ScopedLockType sl(requestLock);
+            // If an evaluator is set, draw exactly one full cycle (0..1).
+            // Otherwise (static preview), show triangles based on numTriangles.
+            request.periods = hasEvaluator ? 1.0f : 0.5f * (float)numTriangles;
+            request.steps = juce::jmax(128, getWidth());
+        }
+
+        if (worker != nullptr && worker->isThreadRunning())
+        {
+            needsCompute.store(true);
+            worker->notify();
+        }
+        else
+        {
+            computePoints();
+            handleUpdateNowIfNeeded();
+        }
+    }
+
+    // Worker thread: evaluate the current request into a fresh point set.
+    void computePoints()
+    {
+        PLF_PROFILE_UI("ScopeTriangles::computePoints (worker)");
+
+        Request rq;
+        {
+            const juce::SpinLock::ScopedLockType sl(requestLock);
+            rq = request;
+        }
+
+        const int n = rq.steps + 1;
+        std::vector<float> phases((size_t)n);
+        auto fillPhases = [&](float periods)
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                const float xNorm = (float)i / (float)rq.steps; // 0..1 across width
+                phases[(size_t)i] = std::fmod(rq.phase01 + xNorm * periods, 1.0f);
+            }
+        };
+
+        Points pts;
+        pts.main.resize((size_t)n);
+        fillPhases(rq.periods);
+        if (rq.evaluator)
+        {
+            rq.evaluator(phases.data(), pts.main.data(), n);
+            juce::FloatVectorOperations::clip(pts.main.data(), pts.main.data(), 0.0f, 1.0f, n);
+        }
+        else
+        {
+            for (int i = 0; i < n; ++i)
+                pts.main[(size_t)i] = LFO::evalCycle(phases[(size_t)i], rq.shape); // unipolar 0..1
+        }
+
+        if (rq.overlayEval)
+        {
+            pts.overlay.resize((size_t)n);
+            fillPhases(1.0f);
+            rq.overlayEval(phases.data(), pts.overlay.data(), n);
+            juce::FloatVectorOperations::clip(pts.overlay.data(), pts.overlay.data(), 0.0f, 1.0f, n);
+        }
+
+        {
+            const juce::SpinLock::ScopedLockType sl(pendingLock);
+            pending = std::move(pts);
+            hasPending = true;
+        }
+        triggerAsyncUpdate();
+    }
+
+    std::atomic<bool> needsCompute{false};
+
+    // With a scheduler, recomputes after a resize wait until the size settles
+    void setScheduler(ScopeRepaintScheduler *s) { scheduler = s; }
+
+    void resized() override; // defined below ScopeRepaintScheduler
+
     void paint(juce::Graphics &g) override
     {
-        auto r = getLocalBounds().toFloat().reduced(8.0f, 6.0f);
+        PLF_PROFILE_UI("ScopeTriangles::paint");
+        PLF_TRACE_SCOPE("ScopeTriangles::paint");
+
+        if (staleWhileHidden)
+            triggerAsyncUpdate(); // painting means we're visible again
+
+        auto r = plotArea();
         if (r.isEmpty())
             return;
 
         const auto grid = findColour(juce::Slider::trackColourId);
         const auto wave = findColour(juce::Slider::thumbColourId);
 
-        // baseline lower (closer to the bottom) + taller triangles
-        const float yBase = r.getBottom() - r.getHeight() * 0.24f; // ~20% above bottom
-        const float amp = r.getHeight() * 0.65f;                   // peaks reach higher
+        const float yBase = baselineY(r);
+        const float amp = r.getHeight() * 0.65f; // peaks reach higher
 
         // Baseline guide
         g.setColour(grid.withAlpha(0.45f));
         g.drawLine({r.getX(), yBase, r.getRight(), yBase}, 1.0f);
 
         // ABB triplet branch (static triangles, unipolar 0..1 visual)
-        if (abTripletMode && numTriangles == 3 && !evaluator)
+        if (abTripletMode && numTriangles == 3 && !hasEvaluator)
         {
+            const auto &shape = request.shape; // only written on this thread
             const float rA = juce::jmax(0.0001f, shape.riseA);
             const float fA = juce::jmax(0.0001f, shape.fallA);
             const float rB = juce::jmax(0.0001f, shape.riseB);
@@ -271,81 +499,329 @@ struct ScopeTriangles : juce::Component
         }
 
         // --- overlay line (e.g., slope/curve hint) --------------------------
-        if (overlayEval)
+        if (!overlayPath.isEmpty())
         {
-            juce::Path hint;
-            const int n = juce::jmax(128, (int)(r.getWidth()));
-            for (int i = 0; i <= n; ++i)
-            {
-                const float xNorm = (float)i / (float)n; // 0..1
-                const float ph = std::fmod(phase01 + xNorm * 1.0f, 1.0f);
-                const float yN = juce::jlimit(0.0f, 1.0f, overlayEval(ph));
-                const float x = r.getX() + xNorm * r.getWidth();
-                const float y = yBase - yN * amp;
-                (i == 0 ? hint.startNewSubPath(x, y) : hint.lineTo(x, y));
-            }
             g.setColour(overlayColour);
-            g.strokePath(hint, juce::PathStrokeType(2.0f));
+            g.strokePath(overlayPath, juce::PathStrokeType(2.0f));
         }
 
-        // If an evaluator is set, draw exactly one full cycle (0..1).
-        // Otherwise (static preview), show triangles based on numTriangles.
-        const float periods = (evaluator ? 1.0f : 0.5f * (float)numTriangles);
+        if (wavePath.isEmpty())
+            return;
 
-        const int steps = juce::jmax(64, (int)r.getWidth());
+        g.setColour(wave.withAlpha(0.22f));
+        g.fillPath(fillPath);
+        g.setColour(wave);
+        g.strokePath(wavePath, juce::PathStrokeType(2.0f, juce::PathStrokeType::curved,
+                                                    juce::PathStrokeType::rounded));
+    }
 
+private:
+    struct Request
+    {
+        int steps = 128;
+        float periods = 1.0f;
+        float phase01 = 0.0f;
+        LFO::Shape shape{};
+        Evaluator evaluator; // if set, used instead of shape
+        Evaluator overlayEval;
+    };
+
+    struct Points
+    {
+        std::vector<float> main, overlay; // 0..1, evenly spaced across the width
+    };
+
+    juce::Rectangle<float> plotArea() const { return getLocalBounds().toFloat().reduced(8.0f, 6.0f); }
+
+    // baseline lower (closer to the bottom) + taller triangles
+    static float baselineY(juce::Rectangle<float> r) { return r.getBottom() - r.getHeight() * 0.24f; }
+
+    void visibilityChanged() override
+    {
+        if (staleWhileHidden && isShowing())
+            invalidate();
+    }
+
+    void handleAsyncUpdate() override
+    {
+        // shown again via a parent (no visibilityChanged here): catch up now
+        if (staleWhileHidden && isShowing())
+            invalidate();
+
+        {
+            const juce::SpinLock::ScopedLockType sl(pendingLock);
+            if (!hasPending)
+                return;
+            points = std::move(pending);
+            hasPending = false;
+        }
+        rebuildPaths();
+        repaint();
+    }
+
+    static juce::Path pathFromPoints(const std::vector<float> &ys, juce::Rectangle<float> r, float yBase, float amp)
+    {
         juce::Path p;
-        bool first = true;
+        const size_t n = ys.size();
+        if (n < 2)
+            return p;
 
-        for (int i = 0; i <= steps; ++i)
+        p.preallocateSpace((int)n * 3 + 8);
+        for (size_t i = 0; i < n; ++i)
         {
-            const float xNorm = (float)i / (float)steps; // 0..1 across width
-            const float ph = std::fmod(phase01 + xNorm * periods, 1.0f);
+            const float x = r.getX() + (float)i / (float)(n - 1) * r.getWidth();
+            const float y = yBase - ys[i] * amp;
+            (i == 0 ? p.startNewSubPath(x, y) : p.lineTo(x, y));
+        }
+        return p;
+    }
+
+    void rebuildPaths()
+    {
+        PLF_PROFILE_UI("ScopeTriangles::rebuildPaths");
+
+        const auto r = plotArea();
+        const float yBase = baselineY(r);
+        const float amp = r.getHeight() * 0.65f;
+
+        wavePath = pathFromPoints(points.main, r, yBase, amp);
+        overlayPath = pathFromPoints(points.overlay, r, yBase, amp);
+
+        fillPath = wavePath;
+        if (!fillPath.isEmpty())
+        {
+            fillPath.lineTo(r.getRight(), yBase);
+            fillPath.lineTo(r.getX(), yBase);
+            fillPath.closeSubPath();
+        }
+    }
+
+    int numTriangles = 2;
+    bool abTripletMode = false;
+    bool hasEvaluator = false;
+    bool staleWhileHidden = true; // message thread only; nothing computed yet
+    juce::Colour overlayColour{juce::Colours::transparentBlack};
+
+    ScopeWorker *worker = nullptr;
+    ScopeRepaintScheduler *scheduler = nullptr;
+
+    juce::SpinLock requestLock; // request: written on the message thread, read by the worker
+    Request request;
+
+    juce::SpinLock pendingLock; // pending: written by the worker, taken on the message thread
+    Points pending;
+    bool hasPending = false;
+
+    Points points; // message thread only
+    juce::Path wavePath, fillPath, overlayPath;
+};
+
+inline void ScopeWorker::run()
+{
+    while (!threadShouldExit())
+    {
+        wait(-1);
+
+        const juce::ScopedLock sl(lock);
+        for (auto *s : scopes)
+        {
+            if (threadShouldExit())
+                return;
+            if (s->needsCompute.exchange(false))
+                s->computePoints();
+        }
+    }
+}
+
+// ---- Coalesces scope recomputes to the display refresh -------------------
+// Parameter callbacks only mark a scope dirty; on each vblank every dirty scope
+// is invalidated once, so a fast drag or automation playback costs at most one
+// recompute per scope per frame. Size changes are held back until the size has
+// stopped changing, so live-resizing only stretches the cached paths.
+class ScopeRepaintScheduler
+{
+public:
+    static constexpr juce::uint32 resizeSettleMs = 150;
 
-            float yN = evaluator ? juce::jlimit(0.0f, 1.0f, evaluator(ph))
-                                 : LFO::evalCycle(ph, shape); // unipolar 0..1
+    explicit ScopeRepaintScheduler(juce::Component &host)
+        : vblank(&host, [this]
+                 { flush(); })
+    {
+    }
+
+    void markDirty(ScopeTriangles &s) { schedule(s, juce::Time::getMillisecondCounter(), false); }
+
+    void markResized(ScopeTriangles &s)
+    {
+        schedule(s, juce::Time::getMillisecondCounter() + resizeSettleMs, true);
+    }
 
-            const float x = r.getX() + xNorm * r.getWidth();
-            const float y = yBase - yN * amp;
+    // A scope that is about to be destroyed must not stay queued.
+    void forget(ScopeTriangles &s)
+    {
+        pending.erase(std::remove_if(pending.begin(), pending.end(), [&s](const Pending &p)
+                                     { return p.scope == &s; }),
+                      pending.end());
+    }
 
-            if (first)
+    void flush()
+    {
+        if (pending.empty())
+            return;
+
+        const auto now = juce::Time::getMillisecondCounter();
+        for (auto it = pending.begin(); it != pending.end();)
+        {
+            if ((juce::int32)(now - it->dueMs) >= 0)
             {
-                p.startNewSubPath(x, y);
-                first = false;
+                it->scope->invalidate();
+                it = pending.erase(it);
             }
             else
             {
-                p.lineTo(x, y);
+                ++it;
             }
         }
+    }
 
-        juce::Path fill = p;
-        fill.lineTo(r.getRight(), yBase);
-        fill.lineTo(r.getX(), yBase);
-        fill.closeSubPath();
+private:
+    struct Pending
+    {
+        ScopeTriangles *scope;
+        juce::uint32 dueMs;
+    };
 
-        g.setColour(wave.withAlpha(0.22f));
-        g.fillPath(fill);
-        g.setColour(wave);
-        g.strokePath(p, juce::PathStrokeType(2.0f, juce::PathStrokeType::curved,
-                                             juce::PathStrokeType::rounded));
+    void schedule(ScopeTriangles &s, juce::uint32 dueMs, bool pushBack)
+    {
+        for (auto &p : pending)
+        {
+            if (p.scope == &s)
+            {
+                // another resize step pushes the deadline out; a value change pulls it in
+                p.dueMs = pushBack ? dueMs : juce::jmin(p.dueMs, dueMs);
+                return;
+            }
+        }
+        pending.push_back({&s, dueMs});
     }
 
+    std::vector<Pending> pending;
+    juce::VBlankAttachment vblank;
+};
+
+inline void ScopeTriangles::resized()
+{
+    rebuildPaths(); // stretch what we have until the new points arrive
+    if (scheduler != nullptr && !points.main.empty())
+        scheduler->markResized(*this);
+    else
+        invalidate();
+}
+
+// ---- One lane's knobs + scope ---------------------------------------------
+// A single component that paints all of a lane's rings itself (same look as
+// Knob / DualKnob via PinkLookAndFeel::drawKnobRing), hit-tests them and binds
+// each ring through a juce::ParameterAttachment — no Slider/Label children.
+// The division pickers (three ComboBoxes, seldom touched) are the exception.
+//
+// The editor builds a panel the first time its tab is shown and drops it again
+// once the tab has been hidden for a while, so open time and memory follow what
+// is on screen rather than the lane count.
+class LanePanel : public juce::Component,
+                  private juce::Timer
+{
+public:
+    LanePanel(PinkELFOntsAudioProcessor &p, int laneNumber, ScopeWorker &worker,
+              ScopeRepaintScheduler &scheduler, std::function<void()> onShapeChanged);
+    ~LanePanel() override;
+
+    void paint(juce::Graphics &) override;
+    void resized() override;
+
+    // Layout scale relative to the 100 % design size (set by the editor)
+    void setUiScale(float newScale);
+
+    void mouseDown(const juce::MouseEvent &) override;
+    void mouseDrag(const juce::MouseEvent &) override;
+    void mouseUp(const juce::MouseEvent &) override;
+    void mouseDoubleClick(const juce::MouseEvent &) override;
+    void mouseWheelMove(const juce::MouseEvent &, const juce::MouseWheelDetails &) override;
+
+    int getLane() const { return lane; }
+
+    // Scope triangle count / A-B-B mode from the lane's current division
+    // (the editor calls this whenever a division parameter moves)
+    void updateDivision();
+
+    juce::uint32 hiddenSinceMs = 0; // set by the editor when the tab is left
+
 private:
-    int numTriangles = 2;
-    float phase01 = 0.0f;
-    LFO::Shape shape{};
-    std::function<float(float)> evaluator; // if set, used instead of shape
-    bool abTripletMode = false;            // NEW
-    std::function<float(float)> overlayEval;
-    juce::Colour overlayColour{juce::Colours::transparentBlack};
+    // One ring, bound to one parameter or two mirrored ones (Time: rise + fall)
+    struct Ring
+    {
+        std::array<juce::RangedAudioParameter *, 2> params{};
+        std::array<std::unique_ptr<juce::ParameterAttachment>, 2> attachments;
+        float value01 = 0.0f; // normalised value of params[0]
+        juce::Rectangle<float> bounds;
+
+        bool isBound() const { return params[0] != nullptr; }
+    };
+
+    struct Control
+    {
+        juce::String caption;
+        bool dual = false;   // outer + inner ring (DualKnob look)
+        Ring outer, inner;   // inner only used when dual
+        juce::Rectangle<int> area;
+    };
+
+    void bind(Ring &ring, std::initializer_list<const char *> paramSuffixes);
+    Ring *ringAt(juce::Point<float> pos);
+    void setRingValue(Ring &ring, float value01);
+    void beginGesture(Ring &ring);
+    void endGesture(Ring &ring);
+    juce::Rectangle<int> areaOf(const Ring &ring) const;
+    void ringChanged(Ring &ring);
+    void renderStaticLayer(float scale);
+    void timerCallback() override; // resize settled
+
+    PinkELFOntsAudioProcessor &processor;
+    const int lane; // 1..kMaxLaneTabs
+    ScopeRepaintScheduler &scheduler;
+    std::function<void()> onShapeChanged;
+
+    // Phase | Invert A | Invert B, then Time A | Time B | Intensity A | Intensity B
+    std::array<Control, 7> controls;
+
+    Ring *dragRing = nullptr;
+    float dragStartValue01 = 0.0f;
+
+    float uiScale = 1.0f;
+
+    // Captions + knob faces, rendered at the display scale; re-rendered once a
+    // resize settles (stretched meanwhile)
+    juce::Image staticLayer;
+    float staticLayerScale = 0.0f;
+    bool staticLayerStale = false;
+
+    ScopeTriangles scope;
+
+    // Division picker in the free slot of the top row: a named division, or
+    // "Free" with the ratio (lane cycles per lane-1 cycle) below it
+    juce::Rectangle<int> divisionArea;
+    juce::ComboBox divisionBox, ratioNumBox, ratioDenBox;
+    using ComboAtt = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
+    std::unique_ptr<ComboAtt> divisionAtt, ratioNumAtt, ratioDenAtt;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LanePanel)
 };
 
 // --------------- main editor ---------------
 
 class PinkELFOntsAudioProcessorEditor
     : public juce::AudioProcessorEditor,
-      public juce::ChangeListener
+      public juce::ChangeListener,
+      private juce::Timer
 {
 public:
     using APVTS = juce::AudioProcessorValueTreeState;
@@ -354,22 +830,22 @@ public:
     ~PinkELFOntsAudioProcessorEditor() override;
 
     void paint(juce::Graphics &) override;
+    void paintOverChildren(juce::Graphics &) override;
     void resized() override;
+    bool keyPressed(const juce::KeyPress &key) override;
 
     void changeListenerCallback(juce::ChangeBroadcaster *source) override;
 
 private:
-    void updateLane1Scope();
-    void updateLane2Scope();
-    void updateLane3Scope();
-    void updateLane4Scope();
-    void updateLane5Scope();
-    void updateLane6Scope();
-    void updateLane7Scope();
-    void updateLane8Scope();
+    // Lane tabs: build the shown lane's panel on demand, hide the others
+    // (the tab after the lanes shows the pattern overview)
+    void showLaneTab(int tab);
+    void updateLaneTabs(); // one tab / mixer strip per active lane, titled by division
+    void timerCallback() override; // drops panels that stayed hidden
 
     // helper
-    bool paramExists(const juce::String &id) const;
+    void refreshPresetBox();
+    void savePresetPrompt();
 
     PinkELFOntsAudioProcessor &processor;
 
@@ -377,6 +853,11 @@ private:
     juce::Label title;
     juce::ComboBox retrigBox;
     juce::ComboBox rateBox;
+    juce::ComboBox lanesBox; // global.numLanes
+
+    // Preset browser (fed by processor.presets, filled in as banks get indexed)
+    juce::ComboBox presetBox;
+    juce::TextButton savePresetBtn{"Save"};
 
     // Tabs
     juce::TabbedComponent laneTabs{juce::TabbedButtonBar::TabsAtTop};
@@ -392,212 +873,78 @@ private:
 
     // Mixer (top-right)
     Section secMixer{"Mixer"};
-    std::array<juce::Slider, 8> mixerFader;
-    std::array<std::unique_ptr<SliderAtt>, 8> mixerFaderAtt;
-    std::array<juce::ToggleButton, 8> mixerOn;
-    std::array<std::unique_ptr<ButtonAtt>, 8> mixerOnAtt;
-    std::array<juce::Label, 8> mixerLbl;
+    std::array<juce::Slider, kMaxLaneTabs> mixerFader;
+    std::array<std::unique_ptr<SliderAtt>, kMaxLaneTabs> mixerFaderAtt;
+    std::array<juce::ToggleButton, kMaxLaneTabs> mixerOn;
+    std::array<std::unique_ptr<ButtonAtt>, kMaxLaneTabs> mixerOnAtt;
+    std::array<juce::Label, kMaxLaneTabs> mixerLbl;
+    std::array<LevelMeter, kMaxLaneTabs> mixerMeter; // lane contribution, next to each fader
+    int numShownLanes = 0;                           // strips / tabs currently laid out
+    void updateMeters();                  // vblank: poll processor.laneMeters
 
     // Global
     Knob depthK{"Depth"};
     Knob phaseNudgeK{"Phase Nudge"};
     DualKnob slopeK{"Slope / Curve"};
 
-    // Lane 1 controls
-    Knob phaseK1{"Phase"};
-    Knob invertA1{"Invert A"};
-    Knob invertB1{"Invert B"};
-    DualKnob timeA1{"Time A / Curve 1"};
-    DualKnob timeB1{"Time B / Curve 2"};
-    DualKnob intensityA1{"Intensity A / Curve 3"};
-    DualKnob intensityB1{"Intensity B / Curve 4"};
-
-    // Lane 2 controls (its own knobs)
-    Knob phaseK2{"Phase"};
-    Knob invertA2{"Invert A"};
-    Knob invertB2{"Invert B"};
-    DualKnob timeA2{"Time A / Curve 1"};
-    DualKnob timeB2{"Time B / Curve 2"};
-    DualKnob intensityA2{"Intensity A / Curve 3"};
-    DualKnob intensityB2{"Intensity B / Curve 4"};
-
-    // Lane 3 controls
-    Knob phaseK3{"Phase"};
-    Knob invertA3{"Invert A"};
-    Knob invertB3{"Invert B"};
-    DualKnob timeA3{"Time A / Curve 1"};
-    DualKnob timeB3{"Time B / Curve 2"};
-    DualKnob intensityA3{"Intensity A / Curve 3"};
-    DualKnob intensityB3{"Intensity B / Curve 4"};
-
-    // Lane 4 controls (its own knobs)
-    Knob phaseK4{"Phase"};
-    Knob invertA4{"Invert A"};
-    Knob invertB4{"Invert B"};
-    DualKnob timeA4{"Time A / Curve 1"};
-    DualKnob timeB4{"Time B / Curve 2"};
-    DualKnob intensityA4{"Intensity A / Curve 3"};
-    DualKnob intensityB4{"Intensity B / Curve 4"};
-
-    // Lane 5 controls
-    Knob phaseK5{"Phase"};
-    Knob invertA5{"Invert A"};
-    Knob invertB5{"Invert B"};
-    DualKnob timeA5{"Time A / Curve 1"};
-    DualKnob timeB5{"Time B / Curve 2"};
-    DualKnob intensityA5{"Intensity A / Curve 3"};
-    DualKnob intensityB5{"Intensity B / Curve 4"};
-
-    // Lane 6 controls (its own knobs)
-    Knob phaseK6{"Phase"};
-    Knob invertA6{"Invert A"};
-    Knob invertB6{"Invert B"};
-    DualKnob timeA6{"Time A / Curve 1"};
-    DualKnob timeB6{"Time B / Curve 2"};
-    DualKnob intensityA6{"Intensity A / Curve 3"};
-    DualKnob intensityB6{"Intensity B / Curve 4"};
-
-    // Lane 7 (1/32)
-    Knob phaseK7{"Phase"};
-    Knob invertA7{"Invert A"};
-    Knob invertB7{"Invert B"};
-    DualKnob timeA7{"Time A / Curve 1"};
-    DualKnob timeB7{"Time B / Curve 2"};
-    DualKnob intensityA7{"Intensity A"};
-    DualKnob intensityB7{"Intensity B"};
-
-    // Lane 8 (1/32T)
-    Knob phaseK8{"Phase"};
-    Knob invertA8{"Invert A"};
-    Knob invertB8{"Invert B"};
-    DualKnob timeA8{"Time A / Curve 1"};
-    DualKnob timeB8{"Time B / Curve 2"};
-    DualKnob intensityA8{"Intensity A"};
-    DualKnob intensityB8{"Intensity B"};
-
-    // Scopes
-    ScopeTriangles lane1Scope2{2};
-    ScopeTriangles lane2Scope3{3}; // Lane-2 triplet scope (A-B-B)
-    ScopeTriangles lane3Scope2{2};
-    ScopeTriangles lane4Scope3{3}; // Lane-4 triplet scope (A-B-B)
-    ScopeTriangles lane5Scope2{2};
-    ScopeTriangles lane6Scope3{3}; // Lane-6 triplet scope (A-B-B)
-    ScopeTriangles lane7Scope2{2};
-    ScopeTriangles lane8Scope3{3};
+    // Scopes (declared after the worker so they unregister before it stops)
+    ScopeWorker scopeWorker;
 
     // Output-card mixed scope
     ScopeTriangles outputMixScope{2}; // reuse your scope; 2 triangles look fits the motif
     void updateOutputMixScope();      // helper to repaint when things change
 
-    // Global Attachments
-    std::unique_ptr<ComboAtt> retrigAtt;
-    std::unique_ptr<SliderAtt> depthAtt, phaseNudgeAtt;
-    std::unique_ptr<SliderAtt> slopeLenAtt, slopeCurveAtt;
-    std::unique_ptr<ComboAtt> rateAtt;
-
-    // Lane 1 attaches
-    std::unique_ptr<SliderAtt> phase1Att, invertA1Att, invertB1Att;
+    // Declared after the scopes: dirty scopes are invalidated once per vblank
+    ScopeRepaintScheduler scopeScheduler{*this};
 
-    // Time A drives riseA/fallA length + both curves
-    std::unique_ptr<SliderAtt> timeA1LenAtt, timeA1LenFallAtt;
-    std::unique_ptr<SliderAtt> timeA1CurveRiseAtt, timeA1CurveFallAtt;
+    float uiScale = 1.0f; // editor width / design width
 
-    // Time B drives riseB/fallB length + both curves
-    std::unique_ptr<SliderAtt> timeB1LenAtt, timeB1LenFallAtt;
-    std::unique_ptr<SliderAtt> timeB1CurveRiseAtt, timeB1CurveFallAtt;
+    // Lane panels (null until their tab is first shown); declared after the
+    // scheduler and worker so they are destroyed before them
+    std::array<std::unique_ptr<LanePanel>, kMaxLaneTabs> lanePanels;
+    juce::Rectangle<int> laneContentArea;
 
-    // Intensities + their inner curve rings
-    std::unique_ptr<SliderAtt> intensityA1LenAtt, intensityA1CurveAtt;
-    std::unique_ptr<SliderAtt> intensityB1LenAtt, intensityB1CurveAtt;
+    // Last tab: whole-pattern min/max view above the live rendered output
+    OverviewScope overview;
+    HistoryScope liveScope{processor.outputHistory};
 
-    // Lane 2 attaches (created only if params exist)
-    std::unique_ptr<SliderAtt> phase2Att, invertA2Att, invertB2Att;
-
-    // Time A drives riseA/fallA length + both curves
-    std::unique_ptr<SliderAtt> timeA2LenAtt, timeA2LenFallAtt;
-    std::unique_ptr<SliderAtt> timeA2CurveRiseAtt, timeA2CurveFallAtt;
-
-    // Time B drives riseB/fallB length + both curves
-    std::unique_ptr<SliderAtt> timeB2LenAtt, timeB2LenFallAtt;
-    std::unique_ptr<SliderAtt> timeB2CurveRiseAtt, timeB2CurveFallAtt;
-
-    // Intensities + their inner curve rings
-    std::unique_ptr<SliderAtt> intensityA2LenAtt, intensityA2CurveAtt;
-    std::unique_ptr<SliderAtt> intensityB2LenAtt, intensityB2CurveAtt;
-
-    // Lane 3 attaches
-    std::unique_ptr<SliderAtt> phase3Att, invertA3Att, invertB3Att;
-
-    // Time A drives riseA/fallA length + both curves
-    std::unique_ptr<SliderAtt> timeA3LenAtt, timeA3LenFallAtt;
-    std::unique_ptr<SliderAtt> timeA3CurveRiseAtt, timeA3CurveFallAtt;
-
-    // Time B drives riseB/fallB length + both curves
-    std::unique_ptr<SliderAtt> timeB3LenAtt, timeB3LenFallAtt;
-    std::unique_ptr<SliderAtt> timeB3CurveRiseAtt, timeB3CurveFallAtt;
-
-    // Intensities + their inner curve rings
-    std::unique_ptr<SliderAtt> intensityA3LenAtt, intensityA3CurveAtt;
-    std::unique_ptr<SliderAtt> intensityB3LenAtt, intensityB3CurveAtt;
-
-    // Lane 4 attaches (created only if params exist)
-    std::unique_ptr<SliderAtt> phase4Att, invertA4Att, invertB4Att;
-
-    // Time A drives riseA/fallA length + both curves
-    std::unique_ptr<SliderAtt> timeA4LenAtt, timeA4LenFallAtt;
-    std::unique_ptr<SliderAtt> timeA4CurveRiseAtt, timeA4CurveFallAtt;
-
-    // Time B drives riseB/fallB length + both curves
-    std::unique_ptr<SliderAtt> timeB4LenAtt, timeB4LenFallAtt;
-    std::unique_ptr<SliderAtt> timeB4CurveRiseAtt, timeB4CurveFallAtt;
-
-    // Intensities + their inner curve rings
-    std::unique_ptr<SliderAtt> intensityA4LenAtt, intensityA4CurveAtt;
-    std::unique_ptr<SliderAtt> intensityB4LenAtt, intensityB4CurveAtt;
-
-    // Lane 5 attaches
-    std::unique_ptr<SliderAtt> phase5Att, invertA5Att, invertB5Att;
-
-    // Time A drives riseA/fallA length + both curves
-    std::unique_ptr<SliderAtt> timeA5LenAtt, timeA5LenFallAtt;
-    std::unique_ptr<SliderAtt> timeA5CurveRiseAtt, timeA5CurveFallAtt;
-
-    // Time B drives riseB/fallB length + both curves
-    std::unique_ptr<SliderAtt> timeB5LenAtt, timeB5LenFallAtt;
-    std::unique_ptr<SliderAtt> timeB5CurveRiseAtt, timeB5CurveFallAtt;
-
-    // Intensities + their inner curve rings
-    std::unique_ptr<SliderAtt> intensityA5LenAtt, intensityA5CurveAtt;
-    std::unique_ptr<SliderAtt> intensityB5LenAtt, intensityB5CurveAtt;
-
-    // Lane 6 attaches (created only if params exist)
-    std::unique_ptr<SliderAtt> phase6Att, invertA6Att, invertB6Att;
-
-    // Time A drives riseA/fallA length + both curves
-    std::unique_ptr<SliderAtt> timeA6LenAtt, timeA6LenFallAtt;
-    std::unique_ptr<SliderAtt> timeA6CurveRiseAtt, timeA6CurveFallAtt;
-
-    // Time B drives riseB/fallB length + both curves
-    std::unique_ptr<SliderAtt> timeB6LenAtt, timeB6LenFallAtt;
-    std::unique_ptr<SliderAtt> timeB6CurveRiseAtt, timeB6CurveFallAtt;
-
-    // Intensities + their inner curve rings
-    std::unique_ptr<SliderAtt> intensityA6LenAtt, intensityA6CurveAtt;
-    std::unique_ptr<SliderAtt> intensityB6LenAtt, intensityB6CurveAtt;
-
-    // Lane 7 and 9 attachments
-
-    std::unique_ptr<SliderAtt> phase7Att, invertA7Att, invertB7Att;
-    std::unique_ptr<SliderAtt> timeA7LenAtt, timeA7LenFallAtt, timeA7CurveRiseAtt;
-    std::unique_ptr<SliderAtt> timeB7LenAtt, timeB7LenFallAtt, timeB7CurveRiseAtt;
-    std::unique_ptr<SliderAtt> intensityA7LenAtt, intensityA7CurveAtt;
-    std::unique_ptr<SliderAtt> intensityB7LenAtt, intensityB7CurveAtt;
+    // Every lane parameter (and the lane count), whether or not its panel has
+    // been built: automation and presets reach the mixed scope, the overview
+    // and the tab titles through this. The flags may be set on any thread and
+    // are picked up on the next vblank.
+    struct LaneParamListener : APVTS::Listener
+    {
+        std::atomic<bool> changed{false};       // anything in the mix
+        std::atomic<bool> lanesChanged{false};  // a division or the lane count
+        void parameterChanged(const juce::String &id, float) override
+        {
+            if (id == "global.numLanes" || id.endsWith(".division") || id.endsWith(".ratioNum") || id.endsWith(".ratioDen"))
+                lanesChanged.store(true, std::memory_order_release);
+            changed.store(true, std::memory_order_release);
+        }
+    };
+    LaneParamListener laneParamListener;
+    juce::StringArray laneParamIds;
+
+    juce::VBlankAttachment meterVBlank{this, [this]
+                                       {
+                                           updateMeters();
+                                           if (laneParamListener.lanesChanged.exchange(false, std::memory_order_acq_rel))
+                                               updateLaneTabs();
+                                           if (laneParamListener.changed.exchange(false, std::memory_order_acq_rel))
+                                               updateOutputMixScope();
+                                       }};
+
+    // Debug: paint/layout timings (Cmd/Ctrl+Shift+P), frame = paint() .. paintOverChildren()
+    UiProfilerOverlay profilerOverlay;
+    juce::int64 frameStartTicks = 0;
 
-    std::unique_ptr<SliderAtt> phase8Att, invertA8Att, invertB8Att;
-    std::unique_ptr<SliderAtt> timeA8LenAtt, timeA8LenFallAtt, timeA8CurveRiseAtt;
-    std::unique_ptr<SliderAtt> timeB8LenAtt, timeB8LenFallAtt, timeB8CurveRiseAtt;
-    std::unique_ptr<SliderAtt> intensityA8LenAtt, intensityA8CurveAtt;
-    std::unique_ptr<SliderAtt> intensityB8LenAtt, intensityB8CurveAtt;
+    // Global Attachments
+    std::unique_ptr<ComboAtt> retrigAtt;
+    std::unique_ptr<SliderAtt> depthAtt, phaseNudgeAtt;
+    std::unique_ptr<SliderAtt> slopeLenAtt, slopeCurveAtt;
+    std::unique_ptr<ComboAtt> rateAtt;
+    std::unique_ptr<ComboAtt> lanesAtt;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PinkELFOntsAudioProcessorEditor)
 };
\ No newline at end of file
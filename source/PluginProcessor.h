@@ -1,23 +1,52 @@
 #pragma once
 #include <JuceHeader.h>
-#include "LFOShape.h" // LFO math (returns 0..1 for our shape)
+#include <array>
+#include <atomic>
+#include <vector>
+#include "LfoEngine.h"     // the DSP core (lfonts_core, no JUCE)
+#include "OutputHistory.h" // lock-free min/max history of the rendered output
+#include "PresetLibrary.h" // memory-mapped preset banks
+#include "Trace.h"         // optional timeline markers (PLF_TRACE)
 
 class PinkELFOntsAudioProcessor : public juce::AudioProcessor
 {
 public:
     using APVTS = juce::AudioProcessorValueTreeState;
 
+    // Lanes exposed as parameters (the engine takes up to LfoEngine::maxLanes);
+    // global.numLanes picks how many of them render
+    static constexpr int numLanes = 16;
+    static_assert(numLanes <= LfoEngine::maxLanes);
+
     PinkELFOntsAudioProcessor();
-    ~PinkELFOntsAudioProcessor() override = default;
+    ~PinkELFOntsAudioProcessor() override;
 
     // ==== AudioProcessor overrides ====
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void releaseResources() override {}
     bool isBusesLayoutSupported(const BusesLayout &) const override { return true; }
     void processBlock(juce::AudioBuffer<float> &, juce::MidiBuffer &) override;
+    float evalLane(int lane, float ph01) const; // lane = 1..numLanes, ph01 = the lane's own phase
     float evalMixed(float ph01) const;
     float evalSlopeOnly(float ph01) const;
 
+    // Batch evaluators (lane = 1..numLanes): parameters are snapshotted once per call,
+    // then the shared lane kernel runs over all n phases. withNudge = false leaves
+    // the global phase nudge out (the lane scopes).
+    void evalLane(int lane, const float *phases, float *out, int n, bool withNudge = true) const;
+    void evalMixed(const float *phases, float *out, int n) const;
+    void evalSlopeOnly(const float *phases, float *out, int n) const;
+
+    // Length of one full repeat of the mixed output, in lane-1 cycles: the LCM
+    // of the enabled lanes' cycles (and of the output slope, unless it is flat).
+    double getPatternLengthCycles() const;
+
+    // Lanes currently rendered (global.numLanes), and a lane's (1..numLanes)
+    // division with its display name: "1/8T", or "3:2" for a free ratio
+    int getNumActiveLanes() const;
+    LfoEngine::Division getLaneDivision(int lane) const;
+    juce::String getLaneDivisionName(int lane) const;
+
     // UI
     juce::AudioProcessorEditor *createEditor() override;
     bool hasEditor() const override { return true; }
@@ -28,91 +57,124 @@ public:
     bool producesMidi() const override { return false; }
     double getTailLengthSeconds() const override { return 0.0; }
 
-    int getNumPrograms() override { return 1; }
-    int getCurrentProgram() override { return 0; }
-    void setCurrentProgram(int) override {}
-    const juce::String getProgramName(int) override { return {}; }
+    // Programs map onto the preset library (hosts need at least 1)
+    int getNumPrograms() override { return juce::jmax(1, presets.getNumPresets()); }
+    int getCurrentProgram() override { return juce::jmax(0, presets.getCurrentIndex()); }
+    void setCurrentProgram(int index) override { presets.apply(index); }
+    const juce::String getProgramName(int index) override { return presets.getEntry(index).name; }
     void changeProgramName(int, const juce::String &) override {}
 
     void getStateInformation(juce::MemoryBlock &destData) override;
     void setStateInformation(const void *data, int sizeInBytes) override;
 
     // ==== Parameters ====
+#if PLF_TRACE
+    // Declared ahead of apvts so building the parameter layout is traced too
+    Trace::Session traceSession{getDefaultTracePath()};
+    static std::string getDefaultTracePath();
+#endif
     APVTS apvts{*this, nullptr, "PARAMS", createParameterLayout()};
     static APVTS::ParameterLayout createParameterLayout();
 
+    // ==== Presets ====
+    PresetLibrary presets{*this}; // indexed in the background on construction
+
+    // ==== Metering ====
+    OutputHistory outputHistory; // envelope actually rendered, pushed per block
+
+    // Per-lane contribution (lane output x smoothed mix), stored once per block.
+    // peak only ever rises here; the reader exchanges it back to 0 when it looks.
+    struct LaneMeter
+    {
+        std::atomic<float> peak{0.0f}, rms{0.0f};
+    };
+    std::array<LaneMeter, numLanes> laneMeters;
+
     // Transport pull
     void updateTransportInfo();
 
-    // Helpers so the editor (or others) can sample current lanes at any phase (0..1)
-    float evalLane1(float ph01) const;
-    float evalLane2Triplet(float ph01) const; // A, B, B across 3 triangles
-    float evalLane3(float ph01) const;        // 1/8
-    float evalLane4Triplet(float ph01) const; // A, B, B across 3 triangles
-    float evalLane5(float ph01) const;        // 1/16
-    float evalLane6Triplet(float ph01) const; // A, B, B across 3 triangles
-    float evalLane7(float ph01) const;
-    float evalLane8Triplet(float ph01) const;
-
 private:
-    // Build shapes from APVTS
-    LFO::Shape makeLane1Shape() const;
-    LFO::Shape makeLane2Shape() const;
-    LFO::Shape makeLane3Shape() const;
-    LFO::Shape makeLane4Shape() const;
-    LFO::Shape makeLane5Shape() const;
-    LFO::Shape makeLane6Shape() const;
-    LFO::Shape makeLane7Shape() const;
-    LFO::Shape makeLane8Shape() const;
+    // Raw parameter pointers per lane, resolved once in the constructor
+    struct LaneParamRefs
+    {
+        std::atomic<float> *enabled = nullptr, *mix = nullptr, *phaseDeg = nullptr;
+        std::atomic<float> *intensityA = nullptr, *intensityB = nullptr;
+        std::atomic<float> *riseA = nullptr, *fallA = nullptr, *riseB = nullptr, *fallB = nullptr;
+        std::atomic<float> *curvRiseA = nullptr, *curvFallA = nullptr, *curvRiseB = nullptr, *curvFallB = nullptr;
+        std::atomic<float> *invertA = nullptr, *invertB = nullptr;
+        std::atomic<float> *division = nullptr, *ratioNum = nullptr, *ratioDen = nullptr;
+    };
+
+    // Global parameter pointers, resolved once in the constructor
+    struct GlobalParamRefs
+    {
+        std::atomic<float> *depth = nullptr, *phaseNudgeDeg = nullptr, *retrig = nullptr;
+        std::atomic<float> *slope = nullptr, *slopeCurve = nullptr, *rate = nullptr;
+        std::atomic<float> *numLanes = nullptr;
+    };
+
+    // Marks a lane for rebuild whenever one of its parameters moves
+    struct LaneDirtyListener : APVTS::Listener
+    {
+        std::atomic<bool> dirty{true};
+        void parameterChanged(const juce::String &, float) override { dirty.store(true, std::memory_order_release); }
+    };
+
+    // APVTS -> engine parameter structs (via the cached pointers)
+    LfoEngine::LaneParams readLaneParams(int laneIdx) const;
+    LfoEngine::GlobalParams readGlobalParams() const;
+    LfoEngine::Params readParams() const; // full snapshot for the UI evaluators
+
+    // processBlock renders in chunks of this many samples
+    static constexpr int renderChunk = LfoEngine::maxChunk;
+    float envelopeBuf[renderChunk] = {}; // engine output per sample, also fed to outputHistory
+
+    // Offline bounces: blocks of at least two of these render chunk-parallel
+    // on a pool shared by every instance in the process
+    static constexpr int offlineChunk = 2048;
+    struct OfflineRenderPool
+    {
+        juce::ThreadPool pool{juce::ThreadPoolOptions{}
+                                  .withThreadName("pink eLFOnts render")
+                                  .withNumberOfThreads(juce::jmax(1, juce::SystemStats::getNumCpus() - 1))};
+    };
+    juce::SharedResourcePointer<OfflineRenderPool> offlinePool;
+    std::vector<float> offlineEnvelope;                  // samplesPerBlock, sized in prepareToPlay
+    std::vector<LfoEngine::ChunkScratch> offlineScratch; // one per chunk
+    void renderOffline(int numSamples);                  // whole block into offlineEnvelope
 
     // Tempo utility
     double getCurrentBpm() const;
 
-    double outputSlopePhase01 = 0.0; // phase for the global slope/curve
-
-    // Unipolar clamp (we ignore global.range now)
-    static inline float toUnipolar01(float v) { return juce::jlimit(0.0f, 1.0f, v); }
+    // Where the master clock was at a block start, and the host's beat position
+    // there; saved with the state so a reloaded session resumes in phase
+    struct PhaseAnchor
+    {
+        LfoEngine::MasterPosition master;
+        double ppq = 0.0;
+        bool hasPpq = false;
+    };
+    juce::SpinLock anchorLock;  // the audio thread only ever try-locks it
+    PhaseAnchor blockAnchor;    // written by processBlock, read by getStateInformation
+    PhaseAnchor restoredAnchor; // written by setStateInformation, applied by processBlock
+    std::atomic<bool> anchorRestorePending{false}; // set under anchorLock; while set, restoredAnchor is what gets saved
 
     // --- audio/LFO state ---
+    LfoEngine engine;
     double sampleRateHz = 44100.0;
-    double lane1Phase01 = 0.0; // 0..1 phase (2 triangles per full cycle)
-    double lane2Phase01 = 0.0; // 0..1 phase (3 triangles per full cycle, lasts 2 beats)
-    double lane3Phase01 = 0.0; // 0..1 phase (2 triangles per full cycle)
-    double lane4Phase01 = 0.0; // 0..1 phase (3 triangles per full cycle, lasts 2 beats)
-    double lane5Phase01 = 0.0; // 0..1 phase (2 triangles per full cycle)
-    double lane6Phase01 = 0.0; // 0..1 phase (3 triangles per full cycle, lasts 2 beats)
-    double lane7Phase01 = 0.0;
-    double lane8Phase01 = 0.0;
     double carrierPhase = 0.0; // 0..1 phase for the audio carrier (for EF)
 
-    // Returns 0 for A half, 1 for B half based on phase 0..1 of a 2-triangle cycle
-    inline int halfIndexFromPhase(float ph01) const
-    {
-        // 0..0.5 => A, 0.5..1 => B
-        return (ph01 < 0.5f) ? 0 : 1;
-    }
-
-    // Read per-lane half intensities (A=0, B=1). Defaults to 0.5 if missing.
-    inline float laneHalfIntensity(int lane, int halfAB /*0=A,1=B*/) const
-    {
-        const juce::String id = "lane" + juce::String(lane) + (halfAB == 0 ? ".intensityA" : ".intensityB");
-        if (auto *p = apvts.getParameter(id))
-            return p->getValue(); // 0..1
-        return 0.5f;
-    }
+    // Per-lane parameter cache: lanes are only rebuilt (on the audio thread,
+    // at block start) when their listener has flagged them dirty.
+    std::array<LaneParamRefs, numLanes> laneParams{};
+    std::array<LaneDirtyListener, numLanes> laneDirty;
+    GlobalParamRefs globalParams{};
 
     // Carrier for EF visualization
     float carrierHz = 1000.0f;
 
-    // Smoothing
-    float amp01Smooth = 0.0f;
-    float laneMixSmooth[8] = {0};
-
-    // De-click crossfade on retrig
-    int retrigFadeSamplesLeft = 0;
-    float retrigFromAmp = 0.0f;
-
     // Transport/book-keeping
     juce::AudioPlayHead *playHead = nullptr;
     juce::AudioPlayHead::CurrentPositionInfo posInfo{};
+    bool hasPosition = false; // posInfo came from the host this block
 };
\ No newline at end of file
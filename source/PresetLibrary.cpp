@@ -0,0 +1,467 @@
+#include "PresetLibrary.h"
+#include <cstring>
+
+// Banks are written little-endian and mapped straight into memory; every
+// platform we ship (x86_64 / arm64) is little-endian, so values are read in place.
+
+PresetLibrary::PresetLibrary(juce::AudioProcessor &processorToControl)
+    : processor(processorToControl)
+{
+    for (auto *p : processor.getParameters())
+    {
+        const auto *withId = dynamic_cast<juce::AudioProcessorParameterWithID *>(p);
+        const juce::String id = withId != nullptr ? withId->paramID : juce::String();
+
+        paramIds.add(id);
+        paramHashes.push_back(hashId(id));
+        paramDefaults.push_back(p->getDefaultValue());
+
+        isShapeParam.push_back(id.contains(".curve.") || id.contains(".curv.") ||
+                               id.contains(".invert") || id.contains(".intensity"));
+
+        int lane = 0;
+        if (id.startsWith("lane") && id.endsWith(".enabled"))
+            lane = id.fromFirstOccurrenceOf("lane", false, false).upToFirstOccurrenceOf(".", false, false).getIntValue();
+        laneOfEnabledParam.push_back(lane);
+    }
+}
+
+PresetLibrary::~PresetLibrary()
+{
+    indexer.stopThread(4000);
+    cancelPendingUpdate();
+}
+
+juce::File PresetLibrary::getDefaultDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("pink eLFOnts")
+        .getChildFile("Presets");
+}
+
+juce::uint32 PresetLibrary::hashId(const juce::String &id)
+{
+    // FNV-1a (32 bit) over the UTF-8 bytes
+    juce::uint32 h = 2166136261u;
+    for (auto *c = id.toRawUTF8(); *c != 0; ++c)
+    {
+        h ^= (juce::uint8)*c;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+juce::String PresetLibrary::readFixedString(const char *src, int maxBytes)
+{
+    int len = 0;
+    while (len < maxBytes && src[len] != 0)
+        ++len;
+    return juce::String::fromUTF8(src, len);
+}
+
+const char *PresetLibrary::Bank::record(int i) const
+{
+    auto *base = static_cast<const char *>(map->getData());
+    return base + sizeof(BankHeader) + sizeof(juce::uint32) * header.numParams + recordSize() * (size_t)i;
+}
+
+// ==================== scanning / indexing ====================
+
+void PresetLibrary::rescan(const juce::File &dir)
+{
+    indexer.stopThread(4000);
+    directory = dir;
+    indexer.dir = dir;
+    indexer.startThread(juce::Thread::Priority::background);
+}
+
+std::unique_ptr<PresetLibrary::Bank> PresetLibrary::openBank(const juce::File &f) const
+{
+    auto bank = std::make_unique<Bank>();
+    bank->file = f;
+    bank->map = std::make_unique<juce::MemoryMappedFile>(f, juce::MemoryMappedFile::readOnly);
+
+    const auto *data = static_cast<const char *>(bank->map->getData());
+    const size_t size = bank->map->getSize();
+    if (data == nullptr || size < sizeof(BankHeader))
+        return nullptr;
+
+    std::memcpy(&bank->header, data, sizeof(BankHeader));
+    if (std::memcmp(bank->header.magic, "PLFB", 4) != 0 || bank->header.version != bankVersion)
+        return nullptr;
+
+    const size_t tableBytes = sizeof(juce::uint32) * bank->header.numParams;
+    if (size < sizeof(BankHeader) + tableBytes + bank->recordSize() * bank->header.numPresets)
+        return nullptr; // truncated
+
+    const auto *table = reinterpret_cast<const juce::uint32 *>(data + sizeof(BankHeader));
+    bank->slotToParam.resize(bank->header.numParams, -1);
+    for (juce::uint32 slot = 0; slot < bank->header.numParams; ++slot)
+    {
+        for (size_t p = 0; p < paramHashes.size(); ++p)
+        {
+            if (paramHashes[p] == table[slot])
+            {
+                bank->slotToParam[slot] = (int)p;
+                break;
+            }
+        }
+    }
+
+    return bank;
+}
+
+void PresetLibrary::indexBank(const Bank &bank, int bankIndex, juce::Array<Entry> &out) const
+{
+    out.ensureStorageAllocated(out.size() + (int)bank.header.numPresets);
+
+    for (int r = 0; r < (int)bank.header.numPresets; ++r)
+    {
+        const char *rec = bank.record(r);
+        const float *v = bank.values(r);
+
+        Entry e;
+        e.name = readFixedString(rec, nameBytes);
+        e.tags = readFixedString(rec + nameBytes, tagBytes);
+        e.bank = bankIndex;
+        e.record = r;
+
+        // FNV-1a (64 bit) over the raw bits of every shape value
+        juce::uint64 h = 14695981039346656037ull;
+        for (size_t slot = 0; slot < bank.slotToParam.size(); ++slot)
+        {
+            const int p = bank.slotToParam[slot];
+            if (p < 0)
+                continue;
+
+            if (const int lane = laneOfEnabledParam[(size_t)p]; lane > 0 && lane <= 32 && v[slot] > 0.5f)
+                e.laneMask |= (1u << (lane - 1));
+
+            if (isShapeParam[(size_t)p])
+            {
+                juce::uint32 bits;
+                std::memcpy(&bits, &v[slot], sizeof(bits));
+                for (int b = 0; b < 4; ++b)
+                {
+                    h ^= (bits >> (8 * b)) & 0xFFu;
+                    h *= 1099511628211ull;
+                }
+            }
+        }
+        e.shapeHash = h;
+
+        out.add(std::move(e));
+    }
+}
+
+void PresetLibrary::indexAll()
+{
+    {
+        const juce::ScopedLock sl(lock);
+        banks.clear();
+        entries.clear();
+        currentIndex = -1; // found again below, by currentBank / currentRecord
+    }
+    sendChangeMessage();
+
+    auto files = indexer.dir.findChildFiles(juce::File::findFiles, false, juce::String("*") + fileExtension);
+    files.sort();
+
+    for (const auto &f : files)
+    {
+        if (indexer.threadShouldExit())
+            return;
+
+        auto bank = openBank(f);
+        if (bank == nullptr)
+            continue;
+
+        juce::Array<Entry> found;
+        indexBank(*bank, 0, found);
+
+        {
+            const juce::ScopedLock sl(lock);
+            const int bankIndex = (int)banks.size();
+            for (auto &e : found)
+                e.bank = bankIndex;
+
+            if (f == currentBank && juce::isPositiveAndBelow(currentRecord, found.size()))
+                currentIndex = entries.size() + currentRecord;
+
+            banks.push_back(std::move(bank));
+            entries.addArray(found);
+        }
+
+        // publish per bank so the browser fills in progressively
+        sendChangeMessage();
+    }
+
+    triggerAsyncUpdate();
+}
+
+void PresetLibrary::handleAsyncUpdate()
+{
+    // Program count, names and the current program may all have moved
+    processor.updateHostDisplay(juce::AudioProcessor::ChangeDetails().withProgramChanged(true));
+}
+
+// ==================== queries ====================
+
+int PresetLibrary::getCurrentIndex() const
+{
+    const juce::ScopedLock sl(lock);
+    return currentIndex;
+}
+
+int PresetLibrary::getNumPresets() const
+{
+    const juce::ScopedLock sl(lock);
+    return entries.size();
+}
+
+PresetLibrary::Entry PresetLibrary::getEntry(int index) const
+{
+    const juce::ScopedLock sl(lock);
+    return entries[index];
+}
+
+juce::Array<PresetLibrary::Entry> PresetLibrary::getEntries() const
+{
+    const juce::ScopedLock sl(lock);
+    return entries;
+}
+
+juce::StringArray PresetLibrary::getBankNames() const
+{
+    const juce::ScopedLock sl(lock);
+    juce::StringArray names;
+    for (const auto &b : banks)
+        names.add(b->file.getFileNameWithoutExtension());
+    return names;
+}
+
+// ==================== apply / save ====================
+
+bool PresetLibrary::apply(int index)
+{
+    // Copy the values that actually differ out under the lock; the parameters
+    // are set after it is released, so host and listener callbacks never run
+    // while the library is locked.
+    std::vector<std::pair<juce::AudioProcessorParameter *, float>> changes;
+    {
+        const juce::ScopedLock sl(lock);
+        if (!juce::isPositiveAndBelow(index, entries.size()))
+            return false;
+
+        const auto &e = entries.getReference(index);
+        const auto &bank = *banks[(size_t)e.bank];
+        if (bank.map == nullptr)
+            return false;
+
+        // Parameters the bank has no slot for (added after it was written)
+        // go back to their defaults, so a preset always loads the same way
+        std::vector<float> targets(paramDefaults);
+        const float *v = bank.values(e.record);
+        for (size_t slot = 0; slot < bank.slotToParam.size(); ++slot)
+            if (const int p = bank.slotToParam[slot]; p >= 0)
+                targets[(size_t)p] = juce::jlimit(0.0f, 1.0f, v[slot]);
+
+        const auto &params = processor.getParameters();
+        changes.reserve(targets.size());
+        for (size_t p = 0; p < targets.size(); ++p)
+            if (std::abs(params[(int)p]->getValue() - targets[p]) > 1.0e-6f)
+                changes.emplace_back(params[(int)p], targets[p]);
+
+        currentIndex = index;
+        currentBank = bank.file;
+        currentRecord = e.record;
+    }
+
+    // One gesture around the whole update, so the host records a single edit
+    for (auto &change : changes)
+        change.first->beginChangeGesture();
+    for (auto &[param, value] : changes)
+        param->setValueNotifyingHost(value);
+    for (auto &change : changes)
+        change.first->endChangeGesture();
+
+    return true;
+}
+
+PresetLibrary::BankLayout PresetLibrary::readLayout(const juce::File &bank) const
+{
+    juce::FileInputStream in(bank);
+    if (!in.openedOk())
+        return BankLayout::unreadable;
+
+    if (in.getTotalLength() < (juce::int64)sizeof(BankHeader))
+        return BankLayout::unreadable;
+
+    char magic[4] = {};
+    in.read(magic, 4);
+    const auto version = (juce::uint32)in.readInt();
+    in.readInt(); // numPresets
+    const auto storedParams = (juce::uint32)in.readInt();
+    if (std::memcmp(magic, "PLFB", 4) != 0 || version != bankVersion)
+        return BankLayout::unreadable;
+
+    if (storedParams != (juce::uint32)paramHashes.size())
+        return BankLayout::older;
+
+    for (auto h : paramHashes)
+        if ((juce::uint32)in.readInt() != h)
+            return BankLayout::older;
+
+    return BankLayout::current;
+}
+
+bool PresetLibrary::migrateBank(const juce::File &bank) const
+{
+    juce::MemoryBlock data;
+    if (!bank.loadFileAsData(data) || data.getSize() < sizeof(BankHeader))
+        return false;
+
+    BankHeader header;
+    std::memcpy(&header, data.getData(), sizeof(BankHeader));
+
+    const size_t tableBytes = sizeof(juce::uint32) * header.numParams;
+    const size_t oldRecordSize = size_t(nameBytes + tagBytes) + sizeof(float) * header.numParams;
+    if (data.getSize() < sizeof(BankHeader) + tableBytes + oldRecordSize * header.numPresets)
+        return false; // truncated
+
+    // Current parameter -> slot in the old records (-1 = not stored: default)
+    const auto *base = static_cast<const char *>(data.getData());
+    const auto *table = reinterpret_cast<const juce::uint32 *>(base + sizeof(BankHeader));
+    std::vector<int> paramToSlot(paramHashes.size(), -1);
+    for (size_t p = 0; p < paramHashes.size(); ++p)
+        for (juce::uint32 slot = 0; slot < header.numParams; ++slot)
+            if (table[slot] == paramHashes[p])
+            {
+                paramToSlot[p] = (int)slot;
+                break;
+            }
+
+    // Written next to the bank, then moved over it in one go
+    juce::TemporaryFile temp(bank);
+    {
+        juce::FileOutputStream out(temp.getFile());
+        if (!out.openedOk())
+            return false;
+
+        out.write("PLFB", 4);
+        out.writeInt((int)bankVersion);
+        out.writeInt((int)header.numPresets);
+        out.writeInt((int)paramHashes.size());
+        for (auto h : paramHashes)
+            out.writeInt((int)h);
+
+        const char *record = base + sizeof(BankHeader) + tableBytes;
+        for (juce::uint32 r = 0; r < header.numPresets; ++r, record += oldRecordSize)
+        {
+            const auto *values = reinterpret_cast<const float *>(record + nameBytes + tagBytes);
+            out.write(record, size_t(nameBytes + tagBytes));
+            for (size_t p = 0; p < paramHashes.size(); ++p)
+                out.writeFloat(paramToSlot[p] >= 0 ? values[paramToSlot[p]] : paramDefaults[p]);
+        }
+
+        out.flush();
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+bool PresetLibrary::saveCurrent(const juce::String &name, const juce::String &tags, const juce::File &bank)
+{
+    const auto numParams = (juce::uint32)paramHashes.size();
+
+    // Banks from an older parameter layout are rewritten with the current one
+    // before the new record goes in; anything else that isn't ours is left alone
+    const auto layout = bank.existsAsFile() ? readLayout(bank) : BankLayout::current;
+    if (layout == BankLayout::unreadable)
+        return false;
+
+    // Drop our mapping of this bank before writing to it
+    indexer.stopThread(4000);
+    {
+        const juce::ScopedLock sl(lock);
+        for (auto &b : banks)
+            if (b->file == bank)
+                b->map.reset();
+    }
+
+    // From here on a failure maps the bank again as it is on disk
+    const auto failed = [this]
+    {
+        rescan(directory);
+        return false;
+    };
+
+    if (layout == BankLayout::older && !migrateBank(bank))
+        return failed();
+
+    juce::uint32 numPresets = 0;
+    {
+        juce::FileInputStream in(bank);
+        if (in.openedOk() && in.getTotalLength() >= (juce::int64)sizeof(BankHeader))
+        {
+            in.setPosition(8);
+            numPresets = (juce::uint32)in.readInt();
+        }
+    }
+
+    if (!bank.existsAsFile())
+    {
+        if (!bank.getParentDirectory().createDirectory())
+            return failed();
+
+        juce::FileOutputStream out(bank);
+        if (!out.openedOk())
+            return failed();
+
+        out.write("PLFB", 4);
+        out.writeInt((int)bankVersion);
+        out.writeInt(0);
+        out.writeInt((int)numParams);
+        for (auto h : paramHashes)
+            out.writeInt((int)h);
+
+        out.flush();
+        if (out.getStatus().failed())
+            return failed();
+    }
+
+    {
+        juce::FileOutputStream out(bank); // appends
+        if (!out.openedOk())
+            return failed();
+
+        char fixedName[nameBytes] = {};
+        char fixedTags[tagBytes] = {};
+        name.copyToUTF8(fixedName, (size_t)nameBytes - 1);
+        tags.copyToUTF8(fixedTags, (size_t)tagBytes - 1);
+        out.write(fixedName, nameBytes);
+        out.write(fixedTags, tagBytes);
+
+        for (auto *p : processor.getParameters())
+            out.writeFloat(p->getValue());
+
+        out.setPosition(8);
+        out.writeInt((int)(numPresets + 1));
+        out.flush();
+        if (out.getStatus().failed())
+            return failed();
+    }
+
+    // The new record is the current preset once its bank is indexed again
+    {
+        const juce::ScopedLock sl(lock);
+        currentIndex = -1;
+        currentBank = bank;
+        currentRecord = (int)numPresets;
+    }
+
+    rescan(directory);
+    return true;
+}
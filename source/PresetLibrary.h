@@ -0,0 +1,142 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Preset library backed by memory-mapped bank files (*.plfbank).
+//
+// Bank layout (little-endian, tightly packed):
+//   BankHeader
+//   uint32 paramIdHash[numParams]   FNV-1a of each parameter ID, in the order
+//                                   the values are stored
+//   Record[numPresets]              name[48], tags[80], float values[numParams]
+//
+// Values are normalised (0..1), so applying a preset is a straight copy into
+// the parameters — no ValueTree parsing. Slots are matched to parameters by ID
+// hash, so banks written by an older layout still load (parameters they lack
+// load at their defaults). Saving into such a bank first rewrites it with the
+// current layout.
+//
+// Banks are scanned and indexed on a background thread; listeners get a change
+// message every time a bank has been added to the index, and the host is told
+// the program list changed once a scan completes. The current preset is kept
+// across rescans (by bank file and record).
+// ---------------------------------------------------------------------------
+class PresetLibrary : public juce::ChangeBroadcaster,
+                      private juce::AsyncUpdater
+{
+public:
+    struct Entry
+    {
+        juce::String name, tags;
+        int bank = 0;                 // index into the mapped banks
+        int record = 0;               // record index inside that bank
+        juce::uint32 laneMask = 0;    // bit n = lane n+1 enabled
+        juce::uint64 shapeHash = 0;   // hash of all shape parameter values
+    };
+
+    static constexpr const char *fileExtension = ".plfbank";
+
+    explicit PresetLibrary(juce::AudioProcessor &processorToControl);
+    ~PresetLibrary() override;
+
+    // Default location: <user app data>/pink eLFOnts/Presets
+    static juce::File getDefaultDirectory();
+
+    // (Re)index every bank in dir on the background thread, which becomes the
+    // library's directory. Returns immediately.
+    void rescan(const juce::File &dir = getDefaultDirectory());
+
+    bool isIndexing() const { return indexer.isThreadRunning(); }
+
+    int getNumPresets() const;
+    Entry getEntry(int index) const;
+    juce::Array<Entry> getEntries() const;
+    juce::StringArray getBankNames() const;
+
+    // Push a preset into the processor's parameters: the changed values are
+    // copied out under the lock, then set in one pass inside a single gesture.
+    bool apply(int index);
+    int getCurrentIndex() const;
+
+    // Append the processor's current parameter values to bank (created if
+    // missing, migrated to the current layout if older) and make it the
+    // current preset. False if nothing was written.
+    bool saveCurrent(const juce::String &name, const juce::String &tags,
+                     const juce::File &bank = getDefaultDirectory().getChildFile(juce::String("User") + fileExtension));
+
+private:
+    struct BankHeader
+    {
+        char magic[4];            // "PLFB"
+        juce::uint32 version;     // 1
+        juce::uint32 numPresets;
+        juce::uint32 numParams;
+    };
+
+    static constexpr int nameBytes = 48;
+    static constexpr int tagBytes = 80;
+    static constexpr juce::uint32 bankVersion = 1;
+
+    struct Bank
+    {
+        juce::File file;
+        std::unique_ptr<juce::MemoryMappedFile> map;
+        BankHeader header{};
+        std::vector<int> slotToParam; // bank slot -> processor parameter index (-1 = unknown)
+
+        size_t recordSize() const { return size_t(nameBytes + tagBytes) + sizeof(float) * header.numParams; }
+        const char *record(int i) const;
+        const float *values(int i) const { return reinterpret_cast<const float *>(record(i) + nameBytes + tagBytes); }
+    };
+
+    struct Indexer : juce::Thread
+    {
+        explicit Indexer(PresetLibrary &o) : juce::Thread("pink eLFOnts preset indexer"), owner(o) {}
+        void run() override { owner.indexAll(); }
+
+        PresetLibrary &owner;
+        juce::File dir;
+    };
+
+    static juce::uint32 hashId(const juce::String &id);
+    static juce::String readFixedString(const char *src, int maxBytes);
+
+    enum class BankLayout
+    {
+        current,   // same parameter IDs in the same order
+        older,     // a PLFB bank of this version with another parameter set
+        unreadable // not a bank we can write to
+    };
+    BankLayout readLayout(const juce::File &bank) const;
+    bool migrateBank(const juce::File &bank) const; // rewrite with the current layout
+
+    std::unique_ptr<Bank> openBank(const juce::File &f) const;
+    void indexBank(const Bank &bank, int bankIndex, juce::Array<Entry> &out) const;
+    void indexAll();
+    void handleAsyncUpdate() override; // a scan completed: tell the host
+
+    juce::AudioProcessor &processor;
+
+    // Per-parameter lookup tables, built once from the processor's layout.
+    juce::StringArray paramIds;
+    std::vector<juce::uint32> paramHashes;
+    std::vector<float> paramDefaults; // normalised
+    std::vector<bool> isShapeParam;
+    std::vector<int> laneOfEnabledParam; // lane number for "laneN.enabled", else 0
+
+    juce::CriticalSection lock; // guards banks + entries
+    std::vector<std::unique_ptr<Bank>> banks;
+    juce::Array<Entry> entries;
+
+    Indexer indexer{*this};
+    juce::File directory = getDefaultDirectory(); // the one rescan() last indexed
+
+    // Current preset: its index into entries (-1 until its bank is indexed),
+    // and where it lives, which survives rescans
+    int currentIndex = -1;
+    juce::File currentBank;
+    int currentRecord = -1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetLibrary)
+};
@@ -0,0 +1,195 @@
+#include "Trace.h"
+
+#if PLF_TRACE
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+    struct Event
+    {
+        const char *name;
+        std::int64_t startUs, endUs;
+        int tid;
+    };
+
+    // Bounded multi-producer / single-consumer queue (sequence per cell)
+    constexpr std::uint64_t kCapacity = 1u << 16;
+
+    struct Cell
+    {
+        std::atomic<std::uint64_t> seq{0};
+        Event event{};
+    };
+
+    Cell cells[kCapacity];
+    std::atomic<std::uint64_t> enqueuePos{0};
+    std::uint64_t dequeuePos = 0; // writer thread only
+    std::atomic<std::uint64_t> dropped{0};
+
+    // origin is published by the release store of running (read with acquire
+    // in isRunning()); it is atomic too, as a producer that saw the previous
+    // session may still be reading it when a new one starts
+    std::atomic<bool> running{false};
+    std::atomic<std::chrono::steady_clock::rep> origin{0};
+
+    // Session state (control side; never touched by producers)
+    std::mutex sessionLock;
+    int sessionRefs = 0;
+    std::FILE *file = nullptr;
+    bool firstEvent = true;
+    std::thread writer;
+    std::condition_variable wake;
+    bool stopWriter = false;
+
+    std::atomic<int> nextTid{1};
+
+    int currentTid()
+    {
+        static thread_local int tid = 0;
+        if (tid == 0)
+            tid = nextTid.fetch_add(1, std::memory_order_relaxed);
+        return tid;
+    }
+
+    bool tryPush(const Event &e)
+    {
+        auto pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            auto &cell = cells[pos & (kCapacity - 1)];
+            const auto seq = cell.seq.load(std::memory_order_acquire);
+            const auto diff = (std::int64_t)seq - (std::int64_t)pos;
+            if (diff == 0)
+            {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell.event = e;
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // full: the writer is behind
+            }
+            else
+            {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Writer thread (or stop() after it has joined)
+    void drain()
+    {
+        for (;;)
+        {
+            auto &cell = cells[dequeuePos & (kCapacity - 1)];
+            if (cell.seq.load(std::memory_order_acquire) != dequeuePos + 1)
+                return;
+
+            const Event e = cell.event;
+            cell.seq.store(dequeuePos + kCapacity, std::memory_order_release);
+            ++dequeuePos;
+
+            std::fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%lld,\"dur\":%lld}",
+                         firstEvent ? "" : ",\n", e.name, e.tid, (long long)e.startUs,
+                         (long long)(e.endUs - e.startUs));
+            firstEvent = false;
+        }
+    }
+
+    void writerLoop()
+    {
+        std::unique_lock<std::mutex> lock(sessionLock);
+        while (!stopWriter)
+        {
+            wake.wait_for(lock, std::chrono::milliseconds(50));
+            drain();
+        }
+    }
+}
+
+namespace Trace
+{
+    bool start(const std::string &path)
+    {
+        const std::lock_guard<std::mutex> lock(sessionLock);
+        if (sessionRefs++ > 0)
+            return file != nullptr;
+
+        file = std::fopen(path.c_str(), "w");
+        if (file == nullptr)
+            return false;
+
+        for (std::uint64_t i = 0; i < kCapacity; ++i)
+            cells[i].seq.store(i, std::memory_order_relaxed);
+        enqueuePos.store(0, std::memory_order_relaxed);
+        dequeuePos = 0;
+        dropped.store(0, std::memory_order_relaxed);
+
+        std::fputs("[\n", file);
+        firstEvent = true;
+        origin.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+        stopWriter = false;
+        writer = std::thread(writerLoop);
+        running.store(true, std::memory_order_release);
+        return true;
+    }
+
+    void stop()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(sessionLock);
+            if (sessionRefs == 0 || --sessionRefs > 0 || file == nullptr)
+                return;
+
+            running.store(false, std::memory_order_release);
+            stopWriter = true;
+        }
+        wake.notify_all();
+        writer.join();
+
+        const std::lock_guard<std::mutex> lock(sessionLock);
+        drain();
+        if (const auto lost = dropped.load(std::memory_order_relaxed); lost > 0)
+            std::fprintf(file, "%s{\"name\":\"dropped %llu slices\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":%lld}",
+                         firstEvent ? "" : ",\n", (unsigned long long)lost, (long long)nowUs());
+        std::fputs("\n]\n", file);
+        std::fclose(file);
+        file = nullptr;
+    }
+
+    bool isRunning() { return running.load(std::memory_order_acquire); }
+
+    std::int64_t nowUs()
+    {
+        const std::chrono::steady_clock::time_point start{
+            std::chrono::steady_clock::duration(origin.load(std::memory_order_relaxed))};
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void record(const char *name, std::int64_t startUs, std::int64_t endUs)
+    {
+        if (isRunning() && !tryPush({name, startUs, endUs, currentTid()}))
+            dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+#else
+
+namespace Trace
+{
+    bool start(const std::string &) { return false; }
+    void stop() {}
+    bool isRunning() { return false; }
+    std::int64_t nowUs() { return 0; }
+    void record(const char *, std::int64_t, std::int64_t) {}
+}
+
+#endif // PLF_TRACE
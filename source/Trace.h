@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// ---------------------------------------------------------------------------
+// Optional timeline trace (configure with -DPLF_TRACE=ON).
+//
+// PLF_TRACE_SCOPE("name") records one complete slice for the enclosing scope;
+// PLF_TRACE_NEXT(scope, "name") ends the current slice of a PLF_TRACE_PHASES
+// scope and starts the next one. Slices go into a fixed lock-free queue (no
+// allocation, no locks, safe on the audio thread) that a background writer
+// drains into a Chrome / Perfetto JSON trace (open in ui.perfetto.dev or
+// chrome://tracing).
+//
+// Compiled out, every macro is empty. Names must be string literals.
+// ---------------------------------------------------------------------------
+namespace Trace
+{
+    // Opens the file and starts the writer; nested sessions share the first one
+    bool start(const std::string &path);
+    void stop();
+
+    bool isRunning();
+
+    // Microseconds since the trace started
+    std::int64_t nowUs();
+    void record(const char *name, std::int64_t startUs, std::int64_t endUs);
+
+    struct Scope
+    {
+        explicit Scope(const char *n) : name(n), startUs(isRunning() ? nowUs() : -1) {}
+        ~Scope()
+        {
+            if (startUs >= 0)
+                record(name, startUs, nowUs());
+        }
+
+        // Ends this slice and starts `nextName` in its place
+        void next(const char *nextName)
+        {
+            if (startUs >= 0)
+            {
+                const auto t = nowUs();
+                record(name, startUs, t);
+                startUs = t;
+            }
+            name = nextName;
+        }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        const char *name;
+        std::int64_t startUs;
+    };
+
+    // start() / stop() for an object's lifetime
+    struct Session
+    {
+        explicit Session(const std::string &path) { start(path); }
+        ~Session() { stop(); }
+    };
+}
+
+#define PLF_TRACE_CONCAT_(a, b) a##b
+#define PLF_TRACE_CONCAT(a, b) PLF_TRACE_CONCAT_(a, b)
+
+#if PLF_TRACE
+#define PLF_TRACE_SCOPE(name) const Trace::Scope PLF_TRACE_CONCAT(plfTrace_, __LINE__)(name)
+#define PLF_TRACE_PHASES(var, name) Trace::Scope var(name)
+#define PLF_TRACE_NEXT(var, name) var.next(name)
+#else
+#define PLF_TRACE_SCOPE(name)
+#define PLF_TRACE_PHASES(var, name)
+#define PLF_TRACE_NEXT(var, name)
+#endif
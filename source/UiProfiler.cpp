@@ -0,0 +1,165 @@
+#include "UiProfiler.h"
+#include <algorithm>
+#include <cstring>
+
+UiProfiler &UiProfiler::get()
+{
+    static UiProfiler instance;
+    return instance;
+}
+
+void UiProfiler::setEnabled(bool shouldBeEnabled)
+{
+    if (shouldBeEnabled && !isEnabled())
+        reset(); // every session starts from a clean table
+
+    enabled.store(shouldBeEnabled, std::memory_order_relaxed);
+}
+
+void UiProfiler::record(const char *name, double ms)
+{
+    const juce::SpinLock::ScopedLockType sl(lock);
+
+    auto it = std::find_if(entries.begin(), entries.end(), [name](const Entry &e)
+                           { return e.name == name || std::strcmp(e.name, name) == 0; });
+    if (it == entries.end())
+    {
+        entries.push_back({});
+        it = entries.end() - 1;
+        it->name = name;
+    }
+
+    ++it->calls;
+    ++it->callsThisSecond;
+    it->totalMs += ms;
+    it->maxMs = juce::jmax(it->maxMs, ms);
+}
+
+void UiProfiler::recordFrame(double ms)
+{
+    const juce::SpinLock::ScopedLockType sl(lock);
+
+    frameMs[(size_t)frameWrite] = (float)ms;
+    frameWrite = (frameWrite + 1) % frameHistory;
+    numFrames = juce::jmin(numFrames + 1, frameHistory);
+    ++framesThisSecond;
+}
+
+void UiProfiler::rollSecond()
+{
+    const juce::SpinLock::ScopedLockType sl(lock);
+
+    for (auto &e : entries)
+    {
+        e.callsPerSecond = e.callsThisSecond;
+        e.callsThisSecond = 0;
+    }
+    framesPerSecond = framesThisSecond;
+    framesThisSecond = 0;
+}
+
+void UiProfiler::reset()
+{
+    const juce::SpinLock::ScopedLockType sl(lock);
+
+    entries.clear();
+    numFrames = frameWrite = 0;
+    framesThisSecond = framesPerSecond = 0;
+}
+
+juce::String UiProfiler::getReport() const
+{
+    std::vector<Entry> rows;
+    std::vector<float> frames;
+    int fps = 0;
+    {
+        const juce::SpinLock::ScopedLockType sl(lock);
+        rows = entries;
+        frames.assign(frameMs.begin(), frameMs.begin() + numFrames);
+        fps = framesPerSecond;
+    }
+
+    // Most expensive first
+    std::sort(rows.begin(), rows.end(), [](const Entry &a, const Entry &b)
+              { return a.totalMs > b.totalMs; });
+
+    juce::String out;
+    out << "frames/s " << fps;
+    if (!frames.empty())
+    {
+        std::sort(frames.begin(), frames.end());
+        auto pct = [&](double p)
+        { return frames[(size_t)juce::jlimit(0, (int)frames.size() - 1, (int)std::ceil(p * frames.size()) - 1)]; };
+
+        out << "   frame ms  p50 " << juce::String(pct(0.50), 2)
+            << "  p90 " << juce::String(pct(0.90), 2)
+            << "  p99 " << juce::String(pct(0.99), 2)
+            << "  max " << juce::String(frames.back(), 2);
+    }
+    out << "\n\n";
+
+    out << juce::String("section").paddedRight(' ', 34)
+        << juce::String("calls/s").paddedLeft(' ', 8)
+        << juce::String("avg ms").paddedLeft(' ', 9)
+        << juce::String("max ms").paddedLeft(' ', 9)
+        << juce::String("total ms").paddedLeft(' ', 11) << "\n";
+
+    for (const auto &e : rows)
+    {
+        out << juce::String(e.name).paddedRight(' ', 34)
+            << juce::String(e.callsPerSecond).paddedLeft(' ', 8)
+            << juce::String(e.totalMs / juce::jmax(1, e.calls), 3).paddedLeft(' ', 9)
+            << juce::String(e.maxMs, 3).paddedLeft(' ', 9)
+            << juce::String(e.totalMs, 1).paddedLeft(' ', 11) << "\n";
+    }
+
+    return out;
+}
+
+bool UiProfiler::dumpToFile(const juce::File &file) const
+{
+    return file.replaceWithText("pink eLFOnts UI profile - " + juce::Time::getCurrentTime().toString(true, true) +
+                                "\n\n" + getReport());
+}
+
+// ==================== overlay ====================
+
+UiProfilerOverlay::UiProfilerOverlay()
+{
+    setInterceptsMouseClicks(false, false);
+    setVisible(false);
+}
+
+void UiProfilerOverlay::toggle()
+{
+    const bool show = !isVisible();
+    UiProfiler::get().setEnabled(show);
+    setVisible(show);
+
+    if (show)
+    {
+        toFront(false);
+        startTimer(1000);
+    }
+    else
+    {
+        stopTimer();
+    }
+}
+
+void UiProfilerOverlay::timerCallback()
+{
+    UiProfiler::get().rollSecond();
+    text = UiProfiler::get().getReport();
+    repaint();
+}
+
+void UiProfilerOverlay::paint(juce::Graphics &g)
+{
+    g.setColour(juce::Colour(0xE00B0D10));
+    g.fillRoundedRectangle(getLocalBounds().toFloat(), 8.0f);
+
+    g.setColour(juce::Colour(0xFFE6EBF2));
+    g.setFont(juce::Font(juce::FontOptions(juce::Font::getDefaultMonospacedFontName(), 12.0f, juce::Font::plain)));
+    g.drawMultiLineText(text.isEmpty() ? juce::String("collecting...") : text, 10, 18, getWidth() - 20);
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Lightweight UI profiler for the editor.
+//
+// PLF_PROFILE_UI("name") times the rest of the enclosing scope; the editor
+// additionally reports whole-frame paint times. Disabled it costs one relaxed
+// atomic load per scope. Toggle the overlay with Cmd/Ctrl+Shift+P, dump the
+// table to a text file with Cmd/Ctrl+Shift+D.
+//
+// One instance per process: the look-and-feel is shared between editors, so
+// numbers cover every open editor.
+// ---------------------------------------------------------------------------
+class UiProfiler
+{
+public:
+    static UiProfiler &get();
+
+    void setEnabled(bool shouldBeEnabled);
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Message thread or scope worker; names must be string literals.
+    void record(const char *name, double ms);
+    void recordFrame(double ms);
+
+    // Called once per second by the overlay: turns call counts into rates.
+    void rollSecond();
+    void reset();
+
+    juce::String getReport() const;
+    bool dumpToFile(const juce::File &file) const;
+
+    struct Scope
+    {
+        explicit Scope(const char *n)
+            : name(n), start(UiProfiler::get().isEnabled() ? juce::Time::getHighResolutionTicks() : 0) {}
+
+        ~Scope()
+        {
+            if (start != 0)
+                UiProfiler::get().record(name, juce::Time::highResolutionTicksToSeconds(
+                                                   juce::Time::getHighResolutionTicks() - start) * 1000.0);
+        }
+
+        const char *name;
+        const juce::int64 start;
+    };
+
+private:
+    struct Entry
+    {
+        const char *name = nullptr;
+        int calls = 0;
+        int callsThisSecond = 0;
+        int callsPerSecond = 0;
+        double totalMs = 0.0, maxMs = 0.0;
+    };
+
+    static constexpr int frameHistory = 512;
+
+    std::atomic<bool> enabled{false};
+
+    mutable juce::SpinLock lock; // guards everything below
+    std::vector<Entry> entries;
+    std::array<float, frameHistory> frameMs{};
+    int numFrames = 0, frameWrite = 0;
+    int framesThisSecond = 0, framesPerSecond = 0;
+};
+
+#define PLF_PROFILE_UI(name) const UiProfiler::Scope JUCE_JOIN_MACRO(plfUiProfile_, __LINE__)(name)
+
+// ---- On-screen table, refreshed once per second ----------------------------
+class UiProfilerOverlay : public juce::Component,
+                          private juce::Timer
+{
+public:
+    UiProfilerOverlay();
+
+    void paint(juce::Graphics &) override;
+
+    // Shows / hides the overlay and switches recording with it.
+    void toggle();
+
+private:
+    void timerCallback() override;
+
+    juce::String text;
+};
@@ -0,0 +1,143 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+
+// Shape math only needs the standard library (also built into lfonts_core)
+namespace LFO
+{
+    // jlimit / jmap equivalents
+    inline float limit(float lo, float hi, float v) { return std::min(hi, std::max(lo, v)); }
+    inline float mapTo(float t, float lo, float hi) { return lo + t * (hi - lo); }
+    inline float mapRange(float v, float inLo, float inHi, float outLo, float outHi)
+    {
+        return outLo + (v - inLo) / (inHi - inLo) * (outHi - outLo);
+    }
+
+    // Map |c| in [0..1] to an exponent >= 1 (bigger = stronger effect)
+    inline float expoFromAmount(float a)
+    {
+        a = limit(0.0f, 1.0f, a);
+        return mapTo(a, 1.0f, 5.0f); // 1..5 feels nicely dramatic
+    }
+
+    // shape01: t∈[0,1], c∈[-1,1]
+    //   c < 0 → concave (ease-in):   slow start, then faster  =>  t^e (e>=1)
+    //   c > 0 → convex (ease-out):   fast start, then slower  =>  1 - (1-t)^e (e>=1)
+    inline float shape01(float t, float c)
+    {
+        t = limit(0.0f, 1.0f, t);
+        const float e = expoFromAmount(std::abs(c));
+
+        if (c >= 0.0f) // convex (fast start)
+            return 1.0f - std::pow(1.0f - t, e);
+        else // concave (slow start)
+            return std::pow(t, e);
+    }
+
+    struct Shape
+    {
+        // relative edge lengths
+        float riseA = 1.0f, fallA = 1.0f, riseB = 1.0f, fallB = 1.0f;
+
+        // curvature per edge in [-1..1]
+        float curvRiseA = 0.0f, curvFallA = 0.0f, curvRiseB = 0.0f, curvFallB = 0.0f;
+
+        // invert blend in [0..1] (0 = normal, 1 = fully inverted around 0.5)
+        float invertA = 0.0f, invertB = 0.0f;
+    };
+
+    // One triangle half (upward), returns 0..1 BEFORE inversion blend.
+    inline float evalHalf(float ph01,
+                          float rise, float fall,
+                          float curvRise, float curvFall,
+                          float invertAmt01)
+    {
+        const float split = limit(0.05f, 0.95f, rise / std::max(0.0001f, rise + fall));
+        float y01 = 0.0f;
+
+        if (ph01 < split)
+        {
+            const float t = ph01 / split; // 0..1 along RISE edge
+            y01 = shape01(t, curvRise);   // 0..1 (concave/convex by sign)
+        }
+        else
+        {
+            const float t = (ph01 - split) / (1.0f - split); // 0..1 along FALL edge
+            y01 = 1.0f - shape01(t, curvFall);               // drop 1→0 with same semantics
+        }
+
+        // Invert around 0.5 (blend to mirrored peak)
+        const float inv = limit(0.0f, 1.0f, invertAmt01);
+        y01 = mapTo(inv, y01, 1.0f - y01);
+
+        return limit(0.0f, 1.0f, y01);
+    }
+
+    // Full cycle: A-half then B-half — BOTH positive triangles (EF sees two matching peaks).
+    inline float evalCycle(float ph01, const Shape &s)
+    {
+        const float y01 = (ph01 < 0.5f)
+                              ? evalHalf(ph01 * 2.0f, s.riseA, s.fallA, s.curvRiseA, s.curvFallA, s.invertA)
+                              : evalHalf((ph01 - 0.5f) * 2.0f, s.riseB, s.fallB, s.curvRiseB, s.curvFallB, s.invertB);
+
+        return limit(0.0f, 1.0f, y01);
+    }
+
+    // ---- Pre-computed coefficients ---------------------------------------
+    // Everything evalHalf/evalCycle derive from a Shape (splits, exponents,
+    // clamped invert), computed once when the parameters change.
+    struct HalfCoeffs
+    {
+        float split = 0.5f;                       // rise/(rise+fall), clamped to 0.05..0.95
+        float expRise = 1.0f, expFall = 1.0f;     // exponents from |curv|
+        bool convexRise = true, convexFall = true; // curv >= 0
+        float invert = 0.0f;                      // 0..1
+    };
+
+    struct Coeffs
+    {
+        HalfCoeffs a, b;
+    };
+
+    inline HalfCoeffs prepareHalf(float rise, float fall, float curvRise, float curvFall, float invertAmt01)
+    {
+        HalfCoeffs h;
+        h.split = limit(0.05f, 0.95f, rise / std::max(0.0001f, rise + fall));
+        h.expRise = expoFromAmount(std::abs(curvRise));
+        h.expFall = expoFromAmount(std::abs(curvFall));
+        h.convexRise = curvRise >= 0.0f;
+        h.convexFall = curvFall >= 0.0f;
+        h.invert = limit(0.0f, 1.0f, invertAmt01);
+        return h;
+    }
+
+    inline Coeffs prepare(const Shape &s)
+    {
+        return {prepareHalf(s.riseA, s.fallA, s.curvRiseA, s.curvFallA, s.invertA),
+                prepareHalf(s.riseB, s.fallB, s.curvRiseB, s.curvFallB, s.invertB)};
+    }
+
+    // Same curve as shape01, with the exponent already resolved
+    inline float shape01(float t, float e, bool convex)
+    {
+        t = limit(0.0f, 1.0f, t);
+        return convex ? 1.0f - std::pow(1.0f - t, e) : std::pow(t, e);
+    }
+
+    inline float evalHalf(float ph01, const HalfCoeffs &h)
+    {
+        float y01 = (ph01 < h.split)
+                        ? shape01(ph01 / h.split, h.expRise, h.convexRise)
+                        : 1.0f - shape01((ph01 - h.split) / (1.0f - h.split), h.expFall, h.convexFall);
+
+        y01 = mapTo(h.invert, y01, 1.0f - y01);
+        return limit(0.0f, 1.0f, y01);
+    }
+
+    inline float evalCycle(float ph01, const Coeffs &c)
+    {
+        const float y01 = (ph01 < 0.5f) ? evalHalf(ph01 * 2.0f, c.a)
+                                        : evalHalf((ph01 - 0.5f) * 2.0f, c.b);
+        return limit(0.0f, 1.0f, y01);
+    }
+} // namespace LFO
@@ -0,0 +1,78 @@
+#include "LaneKernelsImpl.h" // baseline bodies
+
+namespace LaneKernels
+{
+    namespace
+    {
+        const Table baselineTable{Isa::baseline, &renderLaneImpl, &depthSlopeImpl, &carrierImpl};
+    }
+
+#if PLF_LANE_KERNELS_X86
+    extern const Table avx2Table;   // LaneKernelsAvx2.cpp
+    extern const Table avx512Table; // LaneKernelsAvx512.cpp
+#endif
+
+    const char *getName(Isa isa)
+    {
+        switch (isa)
+        {
+        case Isa::avx2:
+            return "avx2";
+        case Isa::avx512:
+            return "avx512";
+        case Isa::baseline:
+            break;
+        }
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+        return "sse2";
+#elif defined(__aarch64__) || defined(_M_ARM64)
+        return "neon";
+#else
+        return "generic";
+#endif
+    }
+
+    bool isSupported(Isa isa)
+    {
+        switch (isa)
+        {
+        case Isa::baseline:
+            return true;
+#if PLF_LANE_KERNELS_X86
+        // Reads what the runtime got from CPUID / XGETBV at startup: no locks, cheap
+        case Isa::avx2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case Isa::avx512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") &&
+                   __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq");
+#else
+        default:
+            return false;
+#endif
+        }
+        return false;
+    }
+
+    Isa getBest()
+    {
+        if (isSupported(Isa::avx512))
+            return Isa::avx512;
+        if (isSupported(Isa::avx2))
+            return Isa::avx2;
+        return Isa::baseline;
+    }
+
+    const Table &get(Isa isa)
+    {
+        if (!isSupported(isa))
+            return baselineTable;
+
+#if PLF_LANE_KERNELS_X86
+        if (isa == Isa::avx512)
+            return avx512Table;
+        if (isa == Isa::avx2)
+            return avx2Table;
+#endif
+        return baselineTable;
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include "LFOShape.h"
+
+// ---------------------------------------------------------------------------
+// The engine's vector kernels, built once per instruction set and picked at
+// run time (LfoEngine::prepare() takes the widest one the CPU runs).
+//
+// x86: SSE2 baseline plus AVX2 and AVX-512 variants. They are compiled with
+// target pragmas rather than per-file flags, so universal macOS builds keep
+// working. AArch64: the NEON baseline only. MSVC builds the baseline only.
+// ---------------------------------------------------------------------------
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define PLF_LANE_KERNELS_X86 1
+#else
+#define PLF_LANE_KERNELS_X86 0
+#endif
+
+namespace LaneKernels
+{
+    enum class Isa
+    {
+        baseline, // SSE2 / NEON / whatever the compiler targets
+        avx2,     // + FMA
+        avx512    // F, VL, BW, DQ
+    };
+    constexpr int numIsas = 3;
+
+    struct Table
+    {
+        Isa isa;
+
+        // Lane shape: AB / ABB mapping, curve, invert, intensity gain per half
+        // (phases already offset, 0..1)
+        void (*renderLane)(const LFO::Coeffs &c, float gainA, float gainB, bool triplet,
+                           const float *phases, float *out, int n);
+
+        // inOut = clamp(inOut * depth * output slope gain at phases01)
+        void (*depthSlope)(const float *phases01, float depth, float slope, float slopeCurve, float *inOut, int n);
+
+        // out = sin(2 pi phase) * envelope, phase advancing by inc and wrapping at 1
+        void (*carrier)(const float *envelope, double &phase, double inc, float *out, int n);
+    };
+
+    const char *getName(Isa isa);
+    bool isSupported(Isa isa); // built in, and this CPU / OS runs it
+    Isa getBest();             // widest supported
+
+    // Unsupported ISAs fall back to the baseline
+    const Table &get(Isa isa);
+}
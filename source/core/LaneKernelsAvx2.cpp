@@ -0,0 +1,27 @@
+// AVX2 + FMA build of the lane kernels (only called after a CPUID check)
+#include "LaneKernels.h"
+#include <algorithm>
+#include <cmath>
+
+#if PLF_LANE_KERNELS_X86
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#endif
+
+#include "LaneKernelsImpl.h"
+
+namespace LaneKernels
+{
+    extern const Table avx2Table;
+    const Table avx2Table{Isa::avx2, &renderLaneImpl, &depthSlopeImpl, &carrierImpl};
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+#endif // PLF_LANE_KERNELS_X86
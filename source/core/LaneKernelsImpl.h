@@ -0,0 +1,138 @@
+// Kernel bodies. Included once by each LaneKernels*.cpp, inside that file's
+// target pragma, so every instruction set gets its own copy (internal
+// linkage). Plain loops over small tiles: the compiler vectorises them for
+// whatever the including file targets.
+#include "LaneKernels.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    using LFO::limit;
+    using LFO::mapRange;
+    using LFO::mapTo;
+
+    // Per element exactly what the scalar evalCycle/evalHalf path does
+    void renderLaneImpl(const LFO::Coeffs &c, float gainA, float gainB, bool triplet,
+                        const float *phases, float *out, int n)
+    {
+        constexpr int tile = 64;
+        float t[tile], e[tile], inv[tile], g[tile];
+        int convex[tile], rising[tile];
+
+        // Half coefficients as scalars, so per-sample picks are selects (no
+        // loads through a chosen pointer) and the passes vectorise
+        const float splitA = c.a.split, splitB = c.b.split;
+        const float expRiseA = c.a.expRise, expFallA = c.a.expFall, expRiseB = c.b.expRise, expFallB = c.b.expFall;
+        const int convexRiseA = c.a.convexRise, convexFallA = c.a.convexFall;
+        const int convexRiseB = c.b.convexRise, convexFallB = c.b.convexFall;
+        const float invA = c.a.invert, invB = c.b.invert;
+
+        // Straight edges (curvature 0) have exponent 1, and pow(x, 1) == x; the
+        // convex flip (curvature 0 counts as convex) is still rounded both ways
+        const bool linear = expRiseA == 1.0f && expFallA == 1.0f && expRiseB == 1.0f && expFallB == 1.0f;
+
+        for (int base = 0; base < n; base += tile)
+        {
+            const int count = std::min(tile, n - base);
+
+            // 1) phase → which half, which edge, local t, exponent
+            for (int k = 0; k < count; ++k)
+            {
+                const float ph01 = phases[base + k];
+
+                // AB: unit cycle. ABB: A then B over 2/3, then a forced B half over the last 1/3
+                const float abb = (ph01 < 2.0f / 3.0f) ? ph01 * 1.5f : 0.5f + 0.5f * ((ph01 - 2.0f / 3.0f) * 3.0f);
+                const float u = triplet ? abb : ph01;
+
+                const bool isB = !(u < 0.5f);
+                const float x = isB ? (u - 0.5f) * 2.0f : u * 2.0f;
+                const float split = isB ? splitB : splitA;
+
+                const bool rise = x < split;
+                rising[k] = rise;
+                t[k] = limit(0.0f, 1.0f, rise ? x / split : (x - split) / (1.0f - split));
+                e[k] = isB ? (rise ? expRiseB : expFallB) : (rise ? expRiseA : expFallA);
+                convex[k] = isB ? (rise ? convexRiseB : convexFallB) : (rise ? convexRiseA : convexFallA);
+                inv[k] = isB ? invB : invA;
+                g[k] = isB ? gainB : gainA;
+            }
+
+            // 2) curve (pow on the flipped or plain t); scalar powf calls
+            if (!linear)
+            {
+                for (int k = 0; k < count; ++k)
+                {
+                    const float p = std::pow(convex[k] != 0 ? 1.0f - t[k] : t[k], e[k]);
+                    t[k] = convex[k] != 0 ? 1.0f - p : p; // shape01
+                }
+            }
+            else
+            {
+                for (int k = 0; k < count; ++k)
+                    t[k] = convex[k] != 0 ? 1.0f - (1.0f - t[k]) : t[k];
+            }
+
+            // 3) edge direction, invert blend, clamps, intensity gain
+            for (int k = 0; k < count; ++k)
+            {
+                float y01 = rising[k] != 0 ? t[k] : 1.0f - t[k];
+                y01 = limit(0.0f, 1.0f, mapTo(inv[k], y01, 1.0f - y01));
+                out[base + k] = limit(0.0f, 1.0f, y01 * g[k]);
+            }
+        }
+    }
+
+    // Output slope: slopeAmt01 0 → rise 0..1, 0.5 → flat 1..1, 1 → fall 1..0;
+    // curve01 0 concave, 0.5 linear (exactly!), 1 convex
+    void depthSlopeImpl(const float *phases01, float depth, float slopeAmt01, float curve01, float *inOut, int n)
+    {
+        const float b = 2.0f * (slopeAmt01 - 0.5f);    // [-1..1]
+        const float v0 = (b < 0.0f ? 1.0f + b : 1.0f); // start level
+        const float v1 = (b > 0.0f ? 1.0f - b : 1.0f); // end level
+
+        // Ensure curve01 == 0.5 maps to p == 1 (perfectly linear).
+        const float p = curve01 <= 0.5f ? mapRange(curve01, 0.0f, 0.5f, 0.25f, 1.0f)  // concave → linear
+                                        : mapRange(curve01, 0.5f, 1.0f, 1.0f, 4.0f); // linear → convex
+
+        // Flat: the gain is 1 wherever t lands. Linear: pow(x, 1) == x.
+        // Either way no powf, and the loop vectorises.
+        if (v0 == 1.0f && v1 == 1.0f)
+        {
+            for (int k = 0; k < n; ++k)
+                inOut[k] = limit(0.0f, 1.0f, inOut[k] * depth * 1.0f);
+            return;
+        }
+        if (p == 1.0f)
+        {
+            for (int k = 0; k < n; ++k)
+            {
+                const float gain = limit(0.0f, 1.0f, v0 + (v1 - v0) * limit(0.0f, 1.0f, phases01[k]));
+                inOut[k] = limit(0.0f, 1.0f, inOut[k] * depth * gain);
+            }
+            return;
+        }
+
+        for (int k = 0; k < n; ++k)
+        {
+            const float t = std::pow(limit(0.0f, 1.0f, phases01[k]), p);
+            const float gain = limit(0.0f, 1.0f, v0 + (v1 - v0) * t);
+            inOut[k] = limit(0.0f, 1.0f, inOut[k] * depth * gain);
+        }
+    }
+
+    void carrierImpl(const float *envelope, double &phase, double inc, float *out, int n)
+    {
+        constexpr double twoPi = 6.283185307179586476925286766559;
+
+        double ph = phase;
+        for (int k = 0; k < n; ++k)
+        {
+            out[k] = std::sin(float(twoPi * ph)) * envelope[k];
+            ph += inc;
+            if (ph >= 1.0)
+                ph -= 1.0;
+        }
+        phase = ph;
+    }
+}
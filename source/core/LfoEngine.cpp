@@ -0,0 +1,675 @@
+#include "LfoEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace
+{
+    using LFO::limit;
+    using LFO::mapRange;
+    using LFO::mapTo;
+
+    // ===== Helpers for squaring by intensity ===============================
+    // Both branches end in clamp(x * g), so the gain only depends on amp and is
+    // resolved once per lane (LaneState::gainA/gainB).
+    float intensityGain(float amp /*0..1*/)
+    {
+        // Piecewise: below 0.5 = linear gain up to 1.0; above 0.5 = pre-gain → soft clip
+        if (amp <= 0.5f)
+            return mapRange(amp, 0.0f, 0.5f, 0.0f, 1.0f); // 0..1
+
+        // 0.5..1.0 -> 1..maxPreGain
+        const float maxPreGain = 8.0f;       // tweak hardness of “square”
+        const float t = (amp - 0.5f) * 2.0f; // 0..1
+        return mapTo(t, 1.0f, maxPreGain);   // 1..8
+    }
+
+    using MasterPosition = LfoEngine::MasterPosition;
+
+    // Phases are 64-bit fixed point: 2^64 is one cycle, so wrapping is integer overflow
+    constexpr double kPhaseOne = 18446744073709551616.0; // 2^64
+
+    // ===== 128-bit helpers (once per lane per chunk, never per sample) =====
+    struct Wide
+    {
+        std::uint64_t hi, lo;
+    };
+
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 Uint128; // a GNU extension: keeps -Wpedantic quiet
+#endif
+
+    inline Wide mulWide(std::uint64_t a, std::uint64_t b)
+    {
+#if defined(__SIZEOF_INT128__)
+        const auto p = (Uint128)a * b;
+        return {(std::uint64_t)(p >> 64), (std::uint64_t)p};
+#else
+        const std::uint64_t aLo = a & 0xffffffffu, aHi = a >> 32, bLo = b & 0xffffffffu, bHi = b >> 32;
+        const std::uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+        const std::uint64_t mid = (ll >> 32) + (lh & 0xffffffffu) + (hl & 0xffffffffu);
+        return {hh + (lh >> 32) + (hl >> 32) + (mid >> 32), (mid << 32) | (ll & 0xffffffffu)};
+#endif
+    }
+
+    // (hi:lo) / d for d < 2^32 and hi < d (so the quotient fits 64 bits)
+    inline std::uint64_t divSmall(Wide x, std::uint32_t d)
+    {
+#if defined(__SIZEOF_INT128__)
+        return (std::uint64_t)((((Uint128)x.hi << 64) | x.lo) / d);
+#else
+        const std::uint64_t top = (x.hi << 32) | (x.lo >> 32);
+        const std::uint64_t bottom = ((top % d) << 32) | (x.lo & 0xffffffffu);
+        return ((top / d) << 32) | (bottom / d);
+#endif
+    }
+
+    // Lane phase at a master position: frac(position * num / den), exact.
+    // Only the cycle count modulo den matters, which keeps it all in 128 bits.
+    inline std::uint64_t ratioPhase(std::int64_t cycle, std::uint64_t phase, std::uint32_t num, std::uint32_t den)
+    {
+        if (den == 1)
+            return phase * num; // whole ratio: the cycle count drops out
+
+        const auto cycleMod = (std::uint64_t)(((cycle % (std::int64_t)den) + den) % den);
+        auto x = mulWide(phase, num);
+        x.hi += cycleMod * num;
+        x.hi %= den; // whole lane cycles drop out
+        return divSmall(x, den);
+    }
+
+    inline MasterPosition advanced(MasterPosition pos, std::uint64_t samples, std::uint64_t inc)
+    {
+        const auto step = mulWide(samples, inc);
+        const std::uint64_t phase = pos.phase + step.lo;
+        return {pos.cycle + (std::int64_t)step.hi + (phase < pos.phase ? 1 : 0), phase};
+    }
+
+    // Top 24 bits -> [0, 1): exact in a float, never reaches 1
+    inline float phaseToFloat(std::uint64_t phase) { return (float)(phase >> 40) * 0x1p-24f; }
+
+    // Any real number of cycles -> its fractional part in fixed point. For a
+    // tiny negative input the fraction rounds to exactly 1.0, which must not
+    // reach the cast: it is held at the largest double below 1.
+    constexpr double kBelowOne = 0x1.fffffffffffffp-1;
+    inline std::uint64_t cyclesToPhase(double cycles)
+    {
+        return (std::uint64_t)(std::min(cycles - std::floor(cycles), kBelowOne) * kPhaseOne);
+    }
+
+    // Scope positions in lane-1 cycles, with exactly 1 kept as the very end of
+    // the first cycle (the slope isn't periodic)
+    inline MasterPosition scopeToPosition(float cycles)
+    {
+        if (cycles == 1.0f)
+            return {0, ~std::uint64_t(0)};
+        return {(std::int64_t)std::floor(std::max(0.0f, cycles)), cyclesToPhase(std::max(0.0f, cycles))};
+    }
+
+    constexpr float kMixSmoothMs = 6.0f; // lane-mix smoother
+    constexpr float kAmpSmoothMs = 2.0f; // final control smoother
+    constexpr float kRetrigFadeMs = 1.0f;
+
+    // A lane mix this close to its target snaps onto it, so the mixer settles
+    // exactly and the cycle cache can engage (-60 dB of one lane's level)
+    constexpr float kMixSettled = 1.0e-3f;
+}
+
+// ==================== setup ====================
+
+void LfoEngine::prepare(double sampleRate)
+{
+    sampleRateHz = sampleRate;
+
+    const float sr = (float)sampleRate;
+    mixSmoothCoeff = 1.0f - std::exp(-1.0f / (kMixSmoothMs * 0.001f * sr));
+    ampSmoothCoeff = 1.0f - std::exp(-1.0f / (kAmpSmoothMs * 0.001f * sr));
+    retrigFadeTotal = std::max(1, (int)std::round(kRetrigFadeMs * 0.001 * sampleRate));
+
+    if (!isaForced)
+        live.kernels = &LaneKernels::get(LaneKernels::getBest());
+
+    if (cache.samples.size() != (size_t)cycleCacheCapacity)
+        cache.samples.resize((size_t)cycleCacheCapacity);
+
+    reset();
+}
+
+void LfoEngine::forceIsa(LaneKernels::Isa isa)
+{
+    isaForced = true;
+    live.kernels = &LaneKernels::get(isa);
+    cache.state = CycleCache::State::idle; // recorded with the other kernels
+}
+
+void LfoEngine::reset()
+{
+    master = {};
+    retrigFadeLeft = 0;
+    cache.state = CycleCache::State::idle;
+}
+
+// ==================== parameters ====================
+
+LFO::Shape LfoEngine::makeShape(const LaneParams &p)
+{
+    LFO::Shape s;
+
+    // Lengths (driven by Time A/B outers)
+    s.riseA = p.riseA;
+    s.fallA = p.fallA;
+    s.riseB = p.riseB;
+    s.fallB = p.fallB;
+
+    // Curvatures [-1..1]  (Time inner → curvRise*, Intensity inner → curvFall*)
+    s.curvRiseA = p.curvRiseA;
+    s.curvFallA = p.curvFallA;
+    s.curvRiseB = p.curvRiseB;
+    s.curvFallB = p.curvFallB;
+
+    // Invert (abs, clamped)
+    s.invertA = limit(0.0f, 1.0f, std::abs(p.invertA));
+    s.invertB = limit(0.0f, 1.0f, std::abs(p.invertB));
+
+    return s;
+}
+
+LfoEngine::LaneState LfoEngine::makeState(const LaneParams &p, float nudgeDeg)
+{
+    LaneState st;
+    st.coeffs = LFO::prepare(makeShape(p));
+    st.phaseOffset = cyclesToPhase((p.phaseDeg + nudgeDeg) / 360.0);
+
+    const int num = std::clamp(p.division.num, 1, maxRatio), den = std::clamp(p.division.den, 1, maxRatio);
+    const int g = std::gcd(num, den);
+    st.ratioNum = (std::uint32_t)(num / g);
+    st.ratioDen = (std::uint32_t)(den / g);
+    st.triplet = p.division.triplet;
+    st.gainA = intensityGain(p.intensityA); // intensity 0..1 -> gain
+    st.gainB = intensityGain(p.intensityB);
+    return st;
+}
+
+void LfoEngine::setLane(int laneIdx, const LaneParams &p)
+{
+    lanes[(size_t)laneIdx].params = p;
+    live.lanes[(size_t)laneIdx] = makeState(p, live.global.phaseNudgeDeg);
+    cache.state = CycleCache::State::idle;
+}
+
+void LfoEngine::setLaneLevel(int laneIdx, bool enabled, float mix)
+{
+    auto &lane = lanes[(size_t)laneIdx];
+    if (lane.params.enabled != enabled || lane.params.mix != mix)
+        cache.state = CycleCache::State::idle;
+    lane.params.enabled = enabled;
+    lane.params.mix = mix;
+}
+
+void LfoEngine::setGlobals(const GlobalParams &g)
+{
+    auto &global = live.global;
+    const int numLanes = std::clamp(g.numLanes, 1, maxLanes);
+    const bool nudgeChanged = g.phaseNudgeDeg != global.phaseNudgeDeg;
+    if (nudgeChanged || g.depth != global.depth || g.slope != global.slope || g.slopeCurve != global.slopeCurve ||
+        g.rateIndex != global.rateIndex || numLanes != global.numLanes)
+        cache.state = CycleCache::State::idle;
+    global = g;
+    global.numLanes = numLanes;
+
+    if (nudgeChanged)
+        for (int i = 0; i < maxLanes; ++i)
+            live.lanes[(size_t)i].phaseOffset = cyclesToPhase((lanes[(size_t)i].params.phaseDeg + g.phaseNudgeDeg) / 360.0);
+}
+
+double LfoEngine::getLanePhase(int laneIdx) const
+{
+    const auto &st = live.lanes[(size_t)laneIdx];
+    return (double)(ratioPhase(master.cycle, master.phase, st.ratioNum, st.ratioDen) + st.phaseOffset) / kPhaseOne;
+}
+
+void LfoEngine::setMasterPosition(MasterPosition position)
+{
+    master = position;
+
+    // a period being recorded would have a jump in it (a finished one is indexed by phase)
+    if (cache.state == CycleCache::State::recording)
+        cache.state = CycleCache::State::idle;
+}
+
+LfoEngine::MasterPosition LfoEngine::advance(MasterPosition pos, double beats, int rateIndex)
+{
+    const double cycles = beats / lane1CycleBeats(rateIndex);
+    const double whole = std::floor(cycles);
+    const std::uint64_t frac = cyclesToPhase(cycles);
+
+    const std::uint64_t phase = pos.phase + frac;
+    return {pos.cycle + (std::int64_t)whole + (phase < pos.phase ? 1 : 0), phase};
+}
+
+double LfoEngine::lane1CycleBeats(int rateIndex)
+{
+    // Global rate scale from "output.rate": 1/4 (base), 1/2, 1 bar, 2 bars, 4 bars
+    static constexpr double rateScale[] = {1.0, 2.0, 4.0, 8.0, 16.0};
+    const int idx = (rateIndex >= 0 && rateIndex < 5) ? rateIndex : 0;
+    return 2.0 * rateScale[idx];
+}
+
+// ==================== rendering ====================
+
+void LfoEngine::retrigger()
+{
+    master = {};
+
+    // crossfade from the current level to the new stream
+    retrigFadeLeft = retrigFadeTotal;
+    retrigFromAmp = ampSmooth;
+}
+
+bool LfoEngine::beginBlock(double bpm)
+{
+    const int numLanes = live.global.numLanes;
+
+    bool anyOn = false, anyMix = false;
+    for (int i = 0; i < numLanes; ++i)
+    {
+        anyOn = anyOn || lanes[(size_t)i].params.enabled;
+        anyMix = anyMix || lanes[(size_t)i].params.mix > 0.0f;
+    }
+    if (live.global.depth <= 0.0f || !anyOn || !anyMix)
+        return false;
+
+    // Master clock = lane 1's cycle (beats, scaled by the output rate) as a fixed-point step
+    const double cyclesPerSec = (bpm / 60.0) / lane1CycleBeats(live.global.rateIndex);
+    masterInc = (std::uint64_t)(cyclesPerSec / sampleRateHz * kPhaseOne);
+
+    bool settled = true;
+    for (int i = 0; i < maxLanes; ++i)
+    {
+        auto &lane = lanes[(size_t)i];
+        const bool on = lane.params.enabled && i < numLanes;
+
+        // smooth mixer targets once per block (then use the mix inside the loop)
+        const float target = on ? lane.params.mix : 0.0f;
+        lane.mixSmooth += mixSmoothCoeff * (target - lane.mixSmooth);
+        if (std::abs(target - lane.mixSmooth) < kMixSettled)
+            lane.mixSmooth = target;
+        settled = settled && lane.mixSmooth == target;
+
+        // a disabled lane is silent while its mix fades out
+        live.mix[(size_t)i] = on ? lane.mixSmooth : 0.0f;
+    }
+    live.updateActiveLanes(); // the lanes mixAt() renders this block
+
+    // A tempo change moves every sample of a cached period
+    if (masterInc != cache.masterInc)
+        cache.state = CycleCache::State::idle;
+
+    if (cacheEnabled && settled && cache.state == CycleCache::State::idle)
+        startCycleCache();
+
+    meters = {};
+    return true;
+}
+
+void LfoEngine::setCycleCacheEnabled(bool shouldCache)
+{
+    cacheEnabled = shouldCache;
+    cache.state = CycleCache::State::idle;
+}
+
+void LfoEngine::startCycleCache()
+{
+    Params p;
+    for (int i = 0; i < maxLanes; ++i)
+        p.lanes[(size_t)i] = lanes[(size_t)i].params;
+    p.global = live.global;
+
+    // Replay is indexed by the master phase, so the period has to fit in one
+    // master cycle; 1 / 2^k of one is a mask in fixed point (a period of 1 / 3
+    // cycle still repeats every whole cycle)
+    std::uint64_t periodCycles = 0, periodDivisions = 0;
+    getPatternPeriod(p, periodCycles, periodDivisions);
+    if (periodCycles != 1)
+        return; // a fractional-ratio lane: keep rendering live
+    periodDivisions &= ~periodDivisions + 1; // largest power of two in it
+
+    // One period plus the sample after it, so replay can always interpolate
+    const double periodSamples = kPhaseOne / (double)periodDivisions / (double)masterInc;
+    if (!(periodSamples + 2.0 <= (double)cache.samples.size()))
+        return; // too long (or no tempo): keep rendering live
+
+    cache.state = CycleCache::State::recording;
+    cache.length = (int)std::ceil(periodSamples) + 1;
+    cache.recorded = 0;
+    cache.startPhase = master.phase;
+    cache.periodMask = ~std::uint64_t(0) / periodDivisions;
+    cache.masterInc = masterInc;
+    cache.meters = {};
+}
+
+void LfoEngine::render(float *out, int n)
+{
+    if (cache.state == CycleCache::State::ready)
+        replayCycle(n);
+    else
+        renderLanes(n);
+
+    applyOutputStage(mixBuf, out, n);
+}
+
+void LfoEngine::applyOutputStage(const float *mix, float *out, int n)
+{
+    for (int k = 0; k < n; ++k)
+    {
+        float amp01 = mix[k];
+
+        // short crossfade on retrig
+        if (retrigFadeLeft > 0)
+        {
+            const float t = 1.0f - (float)retrigFadeLeft / (float)retrigFadeTotal; // 0 -> 1
+            amp01 = retrigFromAmp * (1.0f - t) + amp01 * t;
+            --retrigFadeLeft;
+        }
+
+        // final smoothing
+        ampSmooth += ampSmoothCoeff * (amp01 - ampSmooth);
+        out[k] = ampSmooth;
+    }
+}
+
+void LfoEngine::fillMaster(MasterPosition start, int n, ChunkScratch &scratch) const
+{
+    scratch.start = start;
+    scratch.step = masterInc;
+    scratch.listed = false;
+    for (int k = 0; k < n; ++k)
+        scratch.master[k] = start.phase + (std::uint64_t)k * masterInc;
+}
+
+void LfoEngine::MixState::updateActiveLanes()
+{
+    numActive = 0;
+    for (int i = 0; i < maxLanes; ++i)
+        if (mix[(size_t)i] > 0.0f)
+            active[(size_t)numActive++] = (std::uint8_t)i;
+    mixer = mixKernels[(size_t)numActive];
+}
+
+// The one mixer (DSP, offline chunks and scopes): every lane is read off the
+// master positions in scratch, so lanes can't drift apart or disagree with the UI.
+void LfoEngine::mixAt(const MixState &m, int n, float *mixOut, ChunkScratch &scratch)
+{
+    m.mixer(m, n, mixOut, scratch);
+}
+
+void LfoEngine::renderActiveLane(const MixState &m, int laneIdx, int n, ChunkScratch &scratch)
+{
+    const auto &st = m.lanes[(size_t)laneIdx];
+    const float mix = m.mix[(size_t)laneIdx];
+    float *laneOut = scratch.laneOut[laneIdx];
+
+    // LFOs (0..1): lane phases exact at the chunk start and stepped from
+    // there (exact per sample for listed positions), then one kernel call
+    if (scratch.listed)
+    {
+        for (int k = 0; k < n; ++k)
+            scratch.phase[k] = phaseToFloat(ratioPhase(scratch.cycle[k], scratch.master[k], st.ratioNum, st.ratioDen) +
+                                            st.phaseOffset);
+    }
+    else
+    {
+        const std::uint64_t start =
+            ratioPhase(scratch.start.cycle, scratch.start.phase, st.ratioNum, st.ratioDen) + st.phaseOffset;
+        const std::uint64_t step = ratioPhase(0, scratch.step, st.ratioNum, st.ratioDen);
+        for (int k = 0; k < n; ++k)
+            scratch.phase[k] = phaseToFloat(start + (std::uint64_t)k * step);
+    }
+
+    m.kernels->renderLane(st.coeffs, st.gainA, st.gainB, st.triplet, scratch.phase, laneOut, n);
+
+    float peak = 0.0f, sq = 0.0f;
+    for (int k = 0; k < n; ++k)
+    {
+        peak = std::max(peak, laneOut[k]);
+        sq += laneOut[k] * laneOut[k];
+    }
+    auto &meter = scratch.meters[(size_t)laneIdx];
+    meter.peak = std::max(meter.peak, peak * mix);
+    meter.sumSquares += sq * mix * mix;
+}
+
+template <std::size_t... A>
+void LfoEngine::sumLanes(const float *const *outs, const float *mixes, float *mixOut, int n, std::index_sequence<A...>)
+{
+    for (int k = 0; k < n; ++k)
+    {
+        float amp01 = 0.0f;
+        ((amp01 += outs[A][k] * mixes[A]), ...);
+        mixOut[k] = amp01;
+    }
+}
+
+template <int NumActive>
+void LfoEngine::mixAtCount(const MixState &m, int n, float *mixOut, ChunkScratch &scratch)
+{
+    // Every active lane rendered first, then mixed per sample (in lane order)
+    const float *outs[NumActive > 0 ? NumActive : 1];
+    float mixes[NumActive > 0 ? NumActive : 1];
+    for (int a = 0; a < NumActive; ++a)
+    {
+        const int i = m.active[(size_t)a];
+        renderActiveLane(m, i, n, scratch);
+        outs[a] = scratch.laneOut[i];
+        mixes[a] = m.mix[(size_t)i];
+    }
+
+    sumLanes(outs, mixes, mixOut, n, std::make_index_sequence<(std::size_t)NumActive>{});
+
+    // then depth & slope (on the master phase) and the single safety clamp
+    for (int k = 0; k < n; ++k)
+        scratch.phase[k] = phaseToFloat(scratch.master[k]);
+    m.kernels->depthSlope(scratch.phase, m.global.depth, m.global.slope, m.global.slopeCurve, mixOut, n);
+}
+
+template <std::size_t... Counts>
+constexpr std::array<LfoEngine::MixKernel, sizeof...(Counts)> LfoEngine::makeMixKernels(std::index_sequence<Counts...>)
+{
+    return {{&LfoEngine::mixAtCount<(int)Counts>...}};
+}
+
+// Constant-initialised: no static-init guard on the audio thread
+const std::array<LfoEngine::MixKernel, LfoEngine::maxLanes + 1> LfoEngine::mixKernels =
+    LfoEngine::makeMixKernels(std::make_index_sequence<LfoEngine::maxLanes + 1>{});
+
+void LfoEngine::mergeMeters(ChunkScratch &scratch)
+{
+    for (int a = 0; a < live.numActive; ++a)
+    {
+        const int i = live.active[(size_t)a];
+        auto &from = scratch.meters[(size_t)i];
+        auto &to = meters[(size_t)i];
+        to.peak = std::max(to.peak, from.peak);
+        to.sumSquares += from.sumSquares;
+        from = {};
+    }
+}
+
+void LfoEngine::renderLanes(int n)
+{
+    fillMaster(master, n, liveScratch);
+    mixAt(live, n, mixBuf, liveScratch);
+    master = advanced(master, (std::uint64_t)n, masterInc);
+    mergeMeters(liveScratch);
+
+    // While recording the cycle cache, keep the part of this chunk that still belongs to the period
+    if (cache.state != CycleCache::State::recording)
+        return;
+
+    const int recordN = std::min(n, cache.length - cache.recorded);
+    for (int a = 0; a < live.numActive; ++a)
+    {
+        const int i = live.active[(size_t)a];
+        auto &periodMeter = cache.meters[(size_t)i];
+        for (int k = 0; k < recordN; ++k)
+        {
+            const float v = liveScratch.laneOut[i][k] * live.mix[(size_t)i];
+            periodMeter.peak = std::max(periodMeter.peak, v);
+            periodMeter.sumSquares += v * v;
+        }
+    }
+
+    std::copy(mixBuf, mixBuf + recordN, cache.samples.data() + cache.recorded);
+    cache.recorded += recordN;
+    if (cache.recorded == cache.length)
+        cache.state = CycleCache::State::ready;
+}
+
+void LfoEngine::renderMixChunk(int offset, int n, float *mixOut, ChunkScratch &scratch) const
+{
+    // Master phase straight from the block start (bit-identical to stepping
+    // there): chunks don't depend on each other
+    for (int done = 0; done < n; done += maxChunk)
+    {
+        const int count = std::min(maxChunk, n - done);
+        fillMaster(advanced(master, (std::uint64_t)(offset + done), masterInc), count, scratch);
+        mixAt(live, count, mixOut + done, scratch);
+    }
+}
+
+void LfoEngine::finishBlock(const float *mix, float *out, int numSamples, ChunkScratch *scratches, int numScratches)
+{
+    master = advanced(master, (std::uint64_t)numSamples, masterInc);
+
+    for (int s = 0; s < numScratches; ++s)
+        mergeMeters(scratches[s]);
+
+    // A recording in progress has a gap now
+    if (cache.state == CycleCache::State::recording)
+        cache.state = CycleCache::State::idle;
+
+    applyOutputStage(mix, out, numSamples);
+}
+
+void LfoEngine::replayCycle(int n)
+{
+    const float *samples = cache.samples.data();
+    const double samplesPerStep = 1.0 / (double)cache.masterInc;
+
+    for (int k = 0; k < n; ++k)
+    {
+        const std::uint64_t rel = (master.phase - cache.startPhase) & cache.periodMask;
+
+        // Exact replay when the period is a whole number of samples; otherwise
+        // the offset drifts by a fraction per period and we interpolate
+        const double pos = (double)rel * samplesPerStep;
+        const int i = std::min((int)pos, cache.length - 2);
+        const float frac = (float)(pos - i);
+        mixBuf[k] = samples[i] + frac * (samples[i + 1] - samples[i]);
+
+        master.phase += masterInc;
+        master.cycle += master.phase < masterInc ? 1 : 0;
+    }
+
+    // Meters show the recorded period's peak and RMS
+    const float scale = (float)n / (float)cache.length;
+    for (int a = 0; a < live.numActive; ++a)
+    {
+        const int i = live.active[(size_t)a];
+        auto &meter = meters[(size_t)i];
+        meter.peak = std::max(meter.peak, cache.meters[(size_t)i].peak);
+        meter.sumSquares += cache.meters[(size_t)i].sumSquares * scale;
+    }
+}
+
+// ==================== stateless evaluation ====================
+
+void LfoEngine::evalLane(const Params &p, int laneIdx, const float *phases01, float *out, int n)
+{
+    evalLane(p.lanes[(size_t)laneIdx], p.global.phaseNudgeDeg, phases01, out, n);
+}
+
+void LfoEngine::evalLane(const LaneParams &lp, float nudgeDeg, const float *phases01, float *out, int n)
+{
+    const LaneState st = makeState(lp, nudgeDeg);
+    const auto &kernels = LaneKernels::get(LaneKernels::getBest());
+
+    float lanePh[maxChunk];
+    for (int start = 0; start < n; start += maxChunk)
+    {
+        const int count = std::min(maxChunk, n - start);
+        for (int k = 0; k < count; ++k)
+            lanePh[k] = phaseToFloat(cyclesToPhase(phases01[start + k]) + st.phaseOffset);
+
+        kernels.renderLane(st.coeffs, st.gainA, st.gainB, st.triplet, lanePh, out + start, count);
+    }
+}
+
+void LfoEngine::evalMixed(const Params &p, const float *phases01, float *out, int n)
+{
+    // Snapshot everything once
+    MixState m;
+    m.global = p.global;
+    m.kernels = &LaneKernels::get(LaneKernels::getBest());
+    for (int i = 0; i < std::clamp(p.global.numLanes, 1, maxLanes); ++i)
+    {
+        const auto &lp = p.lanes[(size_t)i];
+        m.mix[(size_t)i] = (lp.enabled && lp.mix > 0.0f) ? lp.mix : 0.0f;
+        if (m.mix[(size_t)i] > 0.0f)
+            m.lanes[(size_t)i] = makeState(lp, p.global.phaseNudgeDeg);
+    }
+    m.updateActiveLanes();
+
+    // Same mixer as the DSP, with the master clock at the requested positions
+    ChunkScratch scratch;
+    scratch.listed = true;
+    for (int start = 0; start < n; start += maxChunk)
+    {
+        const int count = std::min(maxChunk, n - start);
+        for (int k = 0; k < count; ++k)
+        {
+            const auto pos = scopeToPosition(phases01[start + k]);
+            scratch.cycle[k] = pos.cycle;
+            scratch.master[k] = pos.phase;
+        }
+
+        mixAt(m, count, out + start, scratch);
+    }
+}
+
+void LfoEngine::evalSlopeOnly(const GlobalParams &g, const float *phases01, float *out, int n)
+{
+    std::fill(out, out + n, 1.0f);
+    LaneKernels::get(LaneKernels::getBest()).depthSlope(phases01, 1.0f, g.slope, g.slopeCurve, out, n);
+}
+
+void LfoEngine::getPatternPeriod(const Params &p, std::uint64_t &cycles, std::uint64_t &divisions)
+{
+    // Lane i repeats every den / num master cycles, so the LCM of the enabled
+    // lanes is lcm(den) / gcd(num) (with both reduced; lcm(1..maxRatio) fits)
+    cycles = 1;
+    divisions = 0;
+    for (int i = 0; i < std::clamp(p.global.numLanes, 1, maxLanes); ++i)
+    {
+        const auto &lp = p.lanes[(size_t)i];
+        if (!lp.enabled || lp.mix <= 0.0f)
+            continue;
+
+        const auto num = (std::uint64_t)std::clamp(lp.division.num, 1, maxRatio);
+        const auto den = (std::uint64_t)std::clamp(lp.division.den, 1, maxRatio);
+        const auto g = std::gcd(num, den);
+        cycles = std::lcm(cycles, den / g);
+        divisions = std::gcd(divisions, num / g);
+    }
+
+    // The slope runs on lane 1's phase: anything but flat repeats per cycle
+    if (divisions == 0 || std::abs(p.global.slope - 0.5f) > 1.0e-4f)
+        divisions = 1;
+}
+
+double LfoEngine::getPatternLengthCycles(const Params &p)
+{
+    std::uint64_t cycles = 0, divisions = 0;
+    getPatternPeriod(p, cycles, divisions);
+    return (double)cycles / (double)divisions;
+}
@@ -0,0 +1,314 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "LaneKernels.h"
+
+// ---------------------------------------------------------------------------
+// The pink eLFOnts engine without the plugin around it: up to maxLanes
+// tempo-synced lanes, each at its own musical division (straight, dotted,
+// triplet, quintuplet or a free ratio; triplet lanes play A-B-B), the mixer
+// with its smoothing, global depth, the output slope stage, retrig fades and
+// the final control smoother.
+//
+// Standard library only (built as lfonts_core). Parameters come in as plain
+// structs; the plugin's processor is a thin adapter that copies APVTS values
+// into them. Real-time safe: nothing allocates or locks outside prepare().
+// Per-lane state lives in fixed arrays of maxLanes; the cost per block grows
+// with the lanes that are actually sounding, not with the capacity.
+// ---------------------------------------------------------------------------
+class LfoEngine
+{
+public:
+    static constexpr int maxLanes = 32;
+    static constexpr int defaultNumLanes = 8;
+    static constexpr int maxChunk = 256; // render() takes at most this many samples
+    static constexpr int maxRatio = 32;  // largest division numerator / denominator
+
+    // A lane's speed: num / den lane cycles per master cycle (lane 1 of the
+    // default layout, 1/4 = two triangles over two beats at the base rate)
+    struct Division
+    {
+        int num = 1, den = 1; // 1..maxRatio each
+        bool triplet = false; // A, B, B across three triangles instead of A, B
+    };
+
+    struct NamedDivision
+    {
+        const char *name;
+        Division division;
+    };
+
+    // The musical choices, in menu order (below the class); anything else is a free ratio
+    static constexpr int numNamedDivisions = 20;
+    static const NamedDivision namedDivisions[numNamedDivisions];
+
+    // Default layout: 1/4, 1/4T, 1/8, 1/8T, 1/16, 1/16T, 1/32, 1/32T, then 1/4
+    static constexpr int getDefaultDivisionIndex(int laneIdx)
+    {
+        constexpr int layout[] = {5, 6, 9, 10, 13, 14, 17, 18};
+        return laneIdx >= 0 && laneIdx < (int)std::size(layout) ? layout[laneIdx] : 5;
+    }
+
+    // One lane's parameters, in plugin units
+    struct LaneParams
+    {
+        bool enabled = false;
+        float mix = 1.0f;                 // 0..1
+        float phaseDeg = 0.0f;            // 0..360
+        float intensityA = 0.5f, intensityB = 0.5f; // 0..1 (0.5 = unity)
+        float riseA = 1.0f, fallA = 1.0f, riseB = 1.0f, fallB = 1.0f;
+        float curvRiseA = 0.0f, curvFallA = 0.0f, curvRiseB = 0.0f, curvFallB = 0.0f; // -1..1
+        float invertA = 0.0f, invertB = 0.0f; // -1..1 (magnitude used)
+        Division division;
+    };
+
+    struct GlobalParams
+    {
+        float depth = 1.0f;         // 0..1
+        float phaseNudgeDeg = 0.0f; // -30..30
+        float slope = 0.5f;         // 0..1 (0.5 = flat)
+        float slopeCurve = 0.5f;    // 0..1 (0.5 = linear)
+        int rateIndex = 0;          // 1/4, 1/2, 1 bar, 2 bars, 4 bars
+        int numLanes = defaultNumLanes; // lanes from this index on are silent
+    };
+
+    struct Params
+    {
+        std::array<LaneParams, maxLanes> lanes{};
+        GlobalParams global{};
+    };
+
+    // Per-lane contribution (lane output x smoothed mix) over the current block
+    struct LaneMeter
+    {
+        float peak = 0.0f;
+        float sumSquares = 0.0f;
+    };
+
+    // ---- setup ----
+    void prepare(double sampleRate); // also reset(); picks the kernel ISA
+    void reset();                    // phases to 0, smoothers to silence
+
+    // Kernels for one instruction set instead of the widest one the CPU runs
+    // (benchmarks, A/B checks); falls back to the baseline if unsupported.
+    // Sticks across prepare().
+    void forceIsa(LaneKernels::Isa isa);
+    const LaneKernels::Table &getKernels() const { return *live.kernels; }
+
+    // ---- parameters (audio thread, between blocks) ----
+    // Full lane update: rebuilds the lane's shape coefficients
+    void setLane(int laneIdx, const LaneParams &p);
+    // Cheap per-block update of on/off and level only
+    void setLaneLevel(int laneIdx, bool enabled, float mix);
+    // A nudge change re-derives every lane's phase offset; lanes past
+    // g.numLanes fall silent like disabled ones
+    void setGlobals(const GlobalParams &g);
+
+    // ---- rendering ----
+    // Note-on retrigger: phases restart, output crossfades over ~1 ms
+    void retrigger();
+
+    // Starts a block at the given tempo: smooths the mixer once, clears the
+    // meters. Returns false when the output is silent (depth 0 or nothing
+    // enabled); the block should then not be rendered, and the state is left
+    // untouched.
+    bool beginBlock(double bpm);
+
+    // Renders the next n (<= maxChunk) samples of the smoothed control signal
+    // (0..1) into out. Call after beginBlock() returned true.
+    void render(float *out, int n);
+
+    // ---- cycle cache ----
+    // With static parameters and tempo the mix (before retrig fade and final
+    // smoothing) repeats every getPatternLengthCycles() lane-1 cycles. Once the
+    // mixer has settled, render() records one period as it goes and from then
+    // on replays it, indexed by lane 1's phase, instead of running the lanes.
+    // Any parameter or tempo change drops the cache. Periods longer than
+    // cycleCacheCapacity samples, or not within one master cycle (a lane with
+    // a fractional ratio), are always rendered live.
+    static constexpr int cycleCacheCapacity = 1 << 19; // ~10.9 s at 48 kHz
+    void setCycleCacheEnabled(bool shouldCache);        // on by default
+    bool isReplayingCycle() const { return cache.state == CycleCache::State::ready; }
+
+    // Master clock position: whole lane-1 cycles plus the fixed-point fraction
+    // (2^64 = one cycle). Lanes slower or not a whole multiple of the master
+    // need the cycle count; lanes at whole ratios only see the fraction.
+    struct MasterPosition
+    {
+        std::int64_t cycle = 0;
+        std::uint64_t phase = 0;
+    };
+
+    // ---- offline (parallel) rendering ----
+    // A block split into chunks that render on any threads: the master phase
+    // at a chunk start comes straight from the block-start phase. Only the
+    // retrig fade and the final smoother run serially, in finishBlock().
+    struct ChunkScratch
+    {
+        std::uint64_t master[maxChunk]; // master phase per sample (the slope runs on it)
+        std::int64_t cycle[maxChunk];   // listed positions only: whole cycles per sample
+        float phase[maxChunk];
+        float laneOut[maxLanes][maxChunk];
+        std::array<LaneMeter, maxLanes> meters{}; // folded in (and cleared) by finishBlock()
+
+        // Evenly spaced samples from start (DSP), or positions listed per sample (scopes)
+        MasterPosition start;
+        std::uint64_t step = 0;
+        bool listed = false;
+    };
+
+    // Pre-smoothing mix of samples [offset, offset + n) of the block started by
+    // beginBlock(). Safe to call concurrently with one scratch per thread.
+    void renderMixChunk(int offset, int n, float *mixOut, ChunkScratch &scratch) const;
+
+    // Completes that block: moves every lane past numSamples, merges the
+    // scratches' meters, then fades / smooths mix into out (may alias mix).
+    void finishBlock(const float *mix, float *out, int numSamples, ChunkScratch *scratches, int numScratches);
+
+    const LaneMeter &getLaneMeter(int laneIdx) const { return meters[(size_t)laneIdx]; }
+    double getLanePhase(int laneIdx) const;
+
+    // ---- master clock position (saved / restored with the plugin state) ----
+    // Every lane phase follows from it
+    MasterPosition getMasterPosition() const { return master; }
+    void setMasterPosition(MasterPosition position);
+
+    // pos moved on by the given (possibly negative) number of beats
+    static MasterPosition advance(MasterPosition pos, double beats, int rateIndex);
+
+    // ---- stateless evaluation on a parameter snapshot (UI, tools) ----
+    // phases01 are lane-1 cycle positions (0..1, or on through a longer pattern);
+    // lane evaluators take the lane's own phase
+    static void evalLane(const Params &p, int laneIdx, const float *phases01, float *out, int n);
+    static void evalLane(const LaneParams &lp, float nudgeDeg, const float *phases01, float *out, int n);
+    static void evalMixed(const Params &p, const float *phases01, float *out, int n);
+    static void evalSlopeOnly(const GlobalParams &g, const float *phases01, float *out, int n);
+
+    // Length of one full repeat of the mixed output, in lane-1 cycles
+    static double getPatternLengthCycles(const Params &p);
+
+    // Lane-1 cycle length in beats at the given rate index (2 beats at 1/4)
+    static double lane1CycleBeats(int rateIndex);
+
+private:
+    // Everything derived from one lane's parameters
+    struct LaneState
+    {
+        LFO::Coeffs coeffs;
+        std::uint64_t phaseOffset = 0;    // (lane phase + global nudge) / 360, fixed point
+        std::uint32_t ratioNum = 1, ratioDen = 1; // division, reduced
+        bool triplet = false;
+        float gainA = 1.0f, gainB = 1.0f; // per-half gain from intensity A/B
+    };
+
+    // What the mixer reads: the live engine's, or a snapshot's for the scopes
+    struct MixState;
+    using MixKernel = void (*)(const MixState &, int, float *, ChunkScratch &);
+
+    struct MixState
+    {
+        std::array<LaneState, maxLanes> lanes{};
+        std::array<float, maxLanes> mix{}; // effective lane level; 0 = not rendered
+        std::array<std::uint8_t, maxLanes> active{}; // lanes with mix > 0, ascending
+        int numActive = 0;
+        MixKernel mixer = nullptr; // mixAtCount<numActive>, picked by updateActiveLanes()
+        GlobalParams global;
+        const LaneKernels::Table *kernels = &LaneKernels::get(LaneKernels::Isa::baseline);
+
+        void updateActiveLanes();
+    };
+
+    struct Lane
+    {
+        LaneParams params;
+        float mixSmooth = 0.0f; // smoothed once per block
+    };
+
+    struct CycleCache
+    {
+        enum class State
+        {
+            idle,
+            recording,
+            ready
+        };
+
+        State state = State::idle;
+        std::vector<float> samples; // cycleCacheCapacity, allocated in prepare()
+        int length = 0;             // one period + 1 sample
+        int recorded = 0;
+        std::uint64_t startPhase = 0; // master phase of samples[0]
+        std::uint64_t periodMask = 0; // period (in master phase) - 1
+        std::uint64_t masterInc = 0;  // master step it was recorded at
+        std::array<LaneMeter, maxLanes> meters{}; // per-lane contribution over the period
+    };
+
+    static LFO::Shape makeShape(const LaneParams &p);
+    static LaneState makeState(const LaneParams &p, float nudgeDeg);
+
+    // Pre-smoothing mix of n (<= maxChunk) samples at the master positions in
+    // scratch; only the active lanes are rendered
+    static void mixAt(const MixState &m, int n, float *mixOut, ChunkScratch &scratch);
+
+    // mixAt() specialised per active-lane count: the per-sample sum unrolls
+    // over exactly NumActive lanes
+    template <int NumActive>
+    static void mixAtCount(const MixState &m, int n, float *mixOut, ChunkScratch &scratch);
+    template <std::size_t... Counts>
+    static constexpr std::array<MixKernel, sizeof...(Counts)> makeMixKernels(std::index_sequence<Counts...>);
+    static const std::array<MixKernel, maxLanes + 1> mixKernels;
+    template <std::size_t... A>
+    static void sumLanes(const float *const *outs, const float *mixes, float *mixOut, int n, std::index_sequence<A...>);
+
+    // One active lane of a chunk into scratch.laneOut[laneIdx], metered
+    static void renderActiveLane(const MixState &m, int laneIdx, int n, ChunkScratch &scratch);
+
+    // Pattern period = cycles / divisions master cycles (LCM of the enabled lanes' cycles)
+    static void getPatternPeriod(const Params &p, std::uint64_t &cycles, std::uint64_t &divisions);
+
+    void fillMaster(MasterPosition start, int n, ChunkScratch &scratch) const;
+    void mergeMeters(ChunkScratch &scratch);
+
+    // render() halves: the pre-smoothing mix of the next n samples into mixBuf, then fade + smoothing
+    void renderLanes(int n);
+    void replayCycle(int n);
+    void applyOutputStage(const float *mix, float *out, int n);
+    void startCycleCache();
+
+    double sampleRateHz = 44100.0;
+    std::array<Lane, maxLanes> lanes;
+    MixState live; // lane states, block mix levels and globals
+
+    // Master beat clock: lane 1's cycle, 64-bit fixed point (2^64 = one cycle).
+    // Every lane phase is derived from it, so this is the only per-sample state.
+    MasterPosition master;
+    std::uint64_t masterInc = 0;
+    std::array<LaneMeter, maxLanes> meters;
+
+    float ampSmooth = 0.0f;   // final control smoother state
+    float ampSmoothCoeff = 0.0f;
+    float mixSmoothCoeff = 0.0f;
+
+    // De-click crossfade on retrig
+    int retrigFadeTotal = 1;
+    int retrigFadeLeft = 0;
+    float retrigFromAmp = 0.0f;
+
+    CycleCache cache;
+    bool cacheEnabled = true;
+
+    bool isaForced = false;
+
+    // render() scratch
+    ChunkScratch liveScratch{};
+    float mixBuf[maxChunk] = {};
+};
+
+inline constexpr LfoEngine::NamedDivision LfoEngine::namedDivisions[LfoEngine::numNamedDivisions] = {
+    {"1/1", {1, 4}},    {"1/2.", {1, 3}}, {"1/2", {1, 2}},  {"1/2T", {1, 2, true}},
+    {"1/4.", {2, 3}},   {"1/4", {1, 1}},  {"1/4T", {1, 1, true}}, {"1/4Q", {5, 4}},
+    {"1/8.", {4, 3}},   {"1/8", {2, 1}},  {"1/8T", {2, 1, true}}, {"1/8Q", {5, 2}},
+    {"1/16.", {8, 3}},  {"1/16", {4, 1}}, {"1/16T", {4, 1, true}}, {"1/16Q", {5, 1}},
+    {"1/32.", {16, 3}}, {"1/32", {8, 1}}, {"1/32T", {8, 1, true}}, {"1/32Q", {10, 1}}};
@@ -0,0 +1,301 @@
+#include "RtCheck.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define PLF_RT_CALLER() _ReturnAddress()
+#else
+#define PLF_RT_CALLER() __builtin_return_address(0)
+#endif
+
+// TLS must not allocate on first touch (it is read from inside malloc)
+#if defined(__GNUC__) && !defined(__APPLE__)
+#define PLF_RT_TLS __attribute__((tls_model("initial-exec"))) thread_local
+#else
+#define PLF_RT_TLS thread_local
+#endif
+
+namespace
+{
+    PLF_RT_TLS int realtimeDepth = 0;
+    PLF_RT_TLS bool insideRecord = false;
+
+    // Open-addressed table keyed by call site; never allocates
+    struct Slot
+    {
+        std::atomic<void *> site{nullptr};
+        std::atomic<int> kind{0};
+        std::atomic<int> count{0};
+    };
+
+    constexpr int kNumSlots = 512;
+    Slot slots[kNumSlots];
+    std::atomic<int> overflow{0}; // violations from sites that found no free slot
+
+    [[maybe_unused]] void record(RtCheck::Kind kind, void *site)
+    {
+        if (realtimeDepth == 0 || insideRecord)
+            return;
+        insideRecord = true;
+
+        const auto hash = (std::size_t)((reinterpret_cast<std::uintptr_t>(site) >> 2) * 2654435761u);
+        bool stored = false;
+        for (int probe = 0; probe < kNumSlots && !stored; ++probe)
+        {
+            auto &s = slots[(hash + (std::size_t)probe) % kNumSlots];
+
+            void *current = s.site.load(std::memory_order_acquire);
+            if (current == nullptr)
+            {
+                if (s.site.compare_exchange_strong(current, site, std::memory_order_acq_rel))
+                {
+                    s.kind.store((int)kind, std::memory_order_relaxed);
+                    current = site;
+                }
+            }
+
+            if (current == site)
+            {
+                s.count.fetch_add(1, std::memory_order_relaxed);
+                stored = true;
+            }
+        }
+        if (!stored)
+            overflow.fetch_add(1, std::memory_order_relaxed);
+
+        insideRecord = false;
+    }
+
+    const char *kindName(RtCheck::Kind k)
+    {
+        switch (k)
+        {
+        case RtCheck::Kind::allocation:
+            return "alloc";
+        case RtCheck::Kind::deallocation:
+            return "free";
+        case RtCheck::Kind::lock:
+            return "lock";
+        }
+        return "?";
+    }
+
+    std::string describeSite(void *site)
+    {
+        std::ostringstream out;
+        out << site;
+#if defined(__unix__) || defined(__APPLE__)
+        Dl_info info{};
+        if (dladdr(site, &info) != 0 && info.dli_sname != nullptr)
+        {
+            int status = 0;
+            char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+            out << "  " << (status == 0 && demangled != nullptr ? demangled : info.dli_sname)
+                << " +" << (static_cast<const char *>(site) - static_cast<const char *>(info.dli_saddr));
+            std::free(demangled);
+        }
+#endif
+        return out.str();
+    }
+}
+
+namespace RtCheck
+{
+    ScopedRealtime::ScopedRealtime(bool isRealtime) : active(isRealtime)
+    {
+        if (active)
+            ++realtimeDepth;
+    }
+
+    ScopedRealtime::~ScopedRealtime()
+    {
+        if (active)
+            --realtimeDepth;
+    }
+
+    bool isEnabled()
+    {
+#if PLF_RT_CHECK
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    std::vector<Violation> getViolations()
+    {
+        std::vector<Violation> out;
+        for (auto &s : slots)
+            if (auto *site = s.site.load(std::memory_order_acquire))
+                if (const int n = s.count.load(std::memory_order_relaxed); n > 0)
+                    out.push_back({(Kind)s.kind.load(std::memory_order_relaxed), site, n});
+
+        std::sort(out.begin(), out.end(), [](const Violation &a, const Violation &b)
+                  { return a.count > b.count; });
+        return out;
+    }
+
+    int getNumViolations()
+    {
+        int total = overflow.load(std::memory_order_relaxed);
+        for (auto &s : slots)
+            total += s.count.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    std::string getReport()
+    {
+        std::ostringstream out;
+        const auto violations = getViolations();
+        out << "real-time violations: " << getNumViolations() << " at " << violations.size() << " call sites\n";
+        for (const auto &v : violations)
+            out << "  " << kindName(v.kind) << "  x" << v.count << "  " << describeSite(v.site) << "\n";
+        if (const int lost = overflow.load(std::memory_order_relaxed); lost > 0)
+            out << "  (+" << lost << " from sites that did not fit the table)\n";
+        return out.str();
+    }
+
+    void reset()
+    {
+        for (auto &s : slots)
+            s.count.store(0, std::memory_order_relaxed);
+        overflow.store(0, std::memory_order_relaxed);
+    }
+}
+
+// ==================== interposition ====================
+#if PLF_RT_CHECK
+
+#if PLF_RT_CHECK_WRAP
+// Linked with -Wl,--wrap=<symbol> (see CMakeLists.txt): every reference from
+// our objects (JUCE included) lands here first.
+extern "C"
+{
+    void *__real_malloc(std::size_t);
+    void *__real_calloc(std::size_t, std::size_t);
+    void *__real_realloc(void *, std::size_t);
+    void __real_free(void *);
+    void *__real__Znwm(std::size_t);
+    void *__real__Znam(std::size_t);
+    void __real__ZdlPv(void *);
+    void __real__ZdaPv(void *);
+    void __real__ZdlPvm(void *, std::size_t);
+    void __real__ZdaPvm(void *, std::size_t);
+    int __real_pthread_mutex_lock(pthread_mutex_t *);
+
+    void *__wrap_malloc(std::size_t n)
+    {
+        record(RtCheck::Kind::allocation, PLF_RT_CALLER());
+        return __real_malloc(n);
+    }
+    void *__wrap_calloc(std::size_t n, std::size_t size)
+    {
+        record(RtCheck::Kind::allocation, PLF_RT_CALLER());
+        return __real_calloc(n, size);
+    }
+    void *__wrap_realloc(void *p, std::size_t n)
+    {
+        record(RtCheck::Kind::allocation, PLF_RT_CALLER());
+        return __real_realloc(p, n);
+    }
+    void __wrap_free(void *p)
+    {
+        if (p != nullptr)
+            record(RtCheck::Kind::deallocation, PLF_RT_CALLER());
+        __real_free(p);
+    }
+    void *__wrap__Znwm(std::size_t n)
+    {
+        record(RtCheck::Kind::allocation, PLF_RT_CALLER());
+        return __real__Znwm(n);
+    }
+    void *__wrap__Znam(std::size_t n)
+    {
+        record(RtCheck::Kind::allocation, PLF_RT_CALLER());
+        return __real__Znam(n);
+    }
+    void __wrap__ZdlPv(void *p)
+    {
+        if (p != nullptr)
+            record(RtCheck::Kind::deallocation, PLF_RT_CALLER());
+        __real__ZdlPv(p);
+    }
+    void __wrap__ZdaPv(void *p)
+    {
+        if (p != nullptr)
+            record(RtCheck::Kind::deallocation, PLF_RT_CALLER());
+        __real__ZdaPv(p);
+    }
+    void __wrap__ZdlPvm(void *p, std::size_t n)
+    {
+        if (p != nullptr)
+            record(RtCheck::Kind::deallocation, PLF_RT_CALLER());
+        __real__ZdlPvm(p, n);
+    }
+    void __wrap__ZdaPvm(void *p, std::size_t n)
+    {
+        if (p != nullptr)
+            record(RtCheck::Kind::deallocation, PLF_RT_CALLER());
+        __real__ZdaPvm(p, n);
+    }
+    int __wrap_pthread_mutex_lock(pthread_mutex_t *m)
+    {
+        record(RtCheck::Kind::lock, PLF_RT_CALLER());
+        return __real_pthread_mutex_lock(m);
+    }
+}
+
+#else
+// Replaceable global allocation functions (allocations only)
+void *operator new(std::size_t n)
+{
+    record(RtCheck::Kind::allocation, PLF_RT_CALLER());
+    if (auto *p = std::malloc(n != 0 ? n : 1))
+        return p;
+    throw std::bad_alloc();
+}
+void *operator new[](std::size_t n)
+{
+    record(RtCheck::Kind::allocation, PLF_RT_CALLER());
+    if (auto *p = std::malloc(n != 0 ? n : 1))
+        return p;
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept
+{
+    if (p != nullptr)
+        record(RtCheck::Kind::deallocation, PLF_RT_CALLER());
+    std::free(p);
+}
+void operator delete[](void *p) noexcept
+{
+    if (p != nullptr)
+        record(RtCheck::Kind::deallocation, PLF_RT_CALLER());
+    std::free(p);
+}
+void operator delete(void *p, std::size_t) noexcept
+{
+    if (p != nullptr)
+        record(RtCheck::Kind::deallocation, PLF_RT_CALLER());
+    std::free(p);
+}
+void operator delete[](void *p, std::size_t) noexcept
+{
+    if (p != nullptr)
+        record(RtCheck::Kind::deallocation, PLF_RT_CALLER());
+    std::free(p);
+}
+#endif
+
+#endif // PLF_RT_CHECK
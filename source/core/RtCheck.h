@@ -0,0 +1,67 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Real-time-safety checker (debug option: configure with -DPLF_RT_CHECK=ON).
+//
+// PLF_RT_SCOPE() marks the calling thread as real-time for the rest of the
+// enclosing scope (processBlock). While it is, every heap allocation / free
+// and every mutex lock made from our code is recorded by call site, without
+// allocating or locking itself. getReport() symbolises the table afterwards.
+//
+// Linux: malloc/calloc/realloc/free, operator new/delete and
+// pthread_mutex_lock are interposed at link time (ld --wrap), so JUCE's own
+// calls are caught too. Elsewhere only the global operator new/delete are
+// replaced: allocations through them are caught, locks are not.
+//
+// Plain C++ on purpose: the benchmark links it without JUCE. Compiled out,
+// PLF_RT_SCOPE() is empty and nothing is interposed.
+// ---------------------------------------------------------------------------
+namespace RtCheck
+{
+    enum class Kind
+    {
+        allocation,
+        deallocation,
+        lock
+    };
+
+    struct Violation
+    {
+        Kind kind;
+        void *site; // return address of the offending call
+        int count;
+    };
+
+    // Marks the calling thread as real-time while alive (nests). With
+    // isRealtime == false it does nothing (e.g. offline bounces).
+    struct ScopedRealtime
+    {
+        ScopedRealtime() : ScopedRealtime(true) {}
+        explicit ScopedRealtime(bool isRealtime);
+        ~ScopedRealtime();
+        ScopedRealtime(const ScopedRealtime &) = delete;
+        ScopedRealtime &operator=(const ScopedRealtime &) = delete;
+
+    private:
+        bool active;
+    };
+
+    // True when the checker is compiled in
+    bool isEnabled();
+
+    // Any non-real-time thread
+    std::vector<Violation> getViolations();
+    int getNumViolations(); // total count over all call sites
+    std::string getReport(); // one line per call site, most frequent first
+    void reset();
+}
+
+#if PLF_RT_CHECK
+#define PLF_RT_SCOPE() const RtCheck::ScopedRealtime plfRtScope_
+#define PLF_RT_SCOPE_IF(isRealtime) const RtCheck::ScopedRealtime plfRtScope_(isRealtime)
+#else
+#define PLF_RT_SCOPE()
+#define PLF_RT_SCOPE_IF(isRealtime)
+#endif